@@ -0,0 +1,253 @@
+/*
+=======================================================================================
+File name:    EventLog.c
+
+Originator:
+
+Description:
+			  Append only event log in NFC memory, see EventLog.h.
+
+=======================================================================================
+ History:
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026  New file
+---------------------------------------------------------------------------------------
+*/
+//Includes
+#include "EventLog.h"
+
+//Private Method Prototypes
+static uint16_t EventLog_readSequencePRIV(uint8_t entry);
+
+/*
+=======================================================================================
+Method name:  EventLog_init()
+
+Originator:
+
+Description:
+	Finds the entry after the newest one from the sequence numbers stored in the
+	NFC: the newest entry is the last one before the sequence breaks. Entries
+	counting down from it without a break are kept as stored, erased memory is an
+	empty log. Adds a power up event.
+
+Resources:	NFC over I2C
+
+=======================================================================================
+History:
+*-----*-------------*---------------------------------------------------*--------------
+1.00	10-16-2026	Original Code
+---------------------------------------------------------------------------------------
+*/
+void EventLog_init(EventLog_STYP *log) {
+	uint8_t i;
+	uint16_t sequence;
+	uint16_t previous;
+
+	log->head = 0;
+	log->pending = 0;
+	previous = EventLog_readSequencePRIV(0);
+	for (i = 1; i < EVENT_LOG_ENTRIES; i++) {
+		sequence = EventLog_readSequencePRIV(i);
+		if (sequence != (uint16_t)(previous + 1)) {
+			log->head = i;
+			break;
+		}
+		previous = sequence;
+	}
+	if ((previous == 0xFFFF) && (log->head == 1)) {
+		log->head = 0;							// Erased memory, log is empty
+		log->stored = 0;
+		log->sequence = 0;
+		EventLog_add(log, EVENT_LOG_POWER_UP, 0);
+		return;
+	}
+	log->sequence = previous + 1;
+	log->stored = 1;
+	for (i = 2; i <= EVENT_LOG_ENTRIES; i++) {
+		sequence = EventLog_readSequencePRIV((uint8_t)((log->head + EVENT_LOG_ENTRIES - i) % EVENT_LOG_ENTRIES));
+		if (sequence != (uint16_t)(previous - (i - 1))) {
+			break;
+		}
+		log->stored = i;
+	}
+	EventLog_add(log, EVENT_LOG_POWER_UP, 0);
+}
+
+/*
+=======================================================================================
+Method name:  EventLog_add()
+
+Originator:
+
+Description:
+	Adds an event to the RAM buffer, it is written to the NFC later by
+	EventLog_flush(). When the buffer is full the last entry becomes an
+	EVENT_LOG_OVERFLOW entry counting the events lost.
+
+Resources:
+
+=======================================================================================
+History:
+*-----*-------------*---------------------------------------------------*--------------
+1.00	10-16-2026	Original Code
+---------------------------------------------------------------------------------------
+*/
+void EventLog_add(EventLog_STYP *log, uint8_t code, uint8_t data) {
+	uint8_t *pEntry;
+
+	if (log->pending >= EVENT_LOG_PENDING) {
+		pEntry = log->pendingEntry[EVENT_LOG_PENDING - 1];
+		if (pEntry[2] != EVENT_LOG_OVERFLOW) {
+			pEntry[2] = EVENT_LOG_OVERFLOW;
+			pEntry[3] = 1;					// The event this entry held
+		}
+		if (pEntry[3] < 0xFF) {
+			pEntry[3]++;
+		}
+		return;
+	}
+	pEntry = log->pendingEntry[log->pending];
+	pEntry[0] = (uint8_t)(log->sequence >> 8);
+	pEntry[1] = (uint8_t)(log->sequence & 0xFF);
+	pEntry[2] = code;
+	pEntry[3] = data;
+	log->sequence++;
+	log->pending++;
+}
+
+/*
+=======================================================================================
+Method name:  EventLog_pending()
+
+Originator:
+
+Description:
+	Returns TRUE when events are waiting to be written to the NFC.
+
+Resources:
+
+=======================================================================================
+History:
+*-----*-------------*---------------------------------------------------*--------------
+1.00	10-16-2026	Original Code
+---------------------------------------------------------------------------------------
+*/
+bool EventLog_pending(EventLog_STYP *log) {
+	return (log->pending != 0);
+}
+
+/*
+=======================================================================================
+Method name:  EventLog_flush()
+
+Originator:
+
+Description:
+	Writes the buffered events to the NFC ring with NFC_compareWrite(), up to the
+	end of the ring in one call. Called by the Scheduler when it has no other
+	NFC write to do, whileWaiting is called while each page is written.
+	Returns NFC_WRITE_ERR if the NFC did not acknowledge, the events are dropped
+	either way so a failing NFC is not written over and over.
+
+Resources:	NFC over I2C
+
+=======================================================================================
+History:
+*-----*-------------*---------------------------------------------------*--------------
+1.00	10-16-2026	Original Code
+---------------------------------------------------------------------------------------
+*/
+uint8_t EventLog_flush(EventLog_STYP *log, NFC_STYP *nfc, void (*whileWaiting)(void)) {
+	uint8_t i;
+	uint8_t j;
+	uint8_t count;
+	uint8_t err;
+
+	count = log->pending;
+	if (count > (EVENT_LOG_ENTRIES - log->head)) {
+		count = EVENT_LOG_ENTRIES - log->head;		// Rest is written from the start of the ring next time
+	}
+	err = NFC_compareWrite(nfc, NFC_EVENT_LOG_OFFSET + ((uint16_t)log->head * EVENT_LOG_ENTRY_SIZE),
+						   log->pendingEntry[0], (uint16_t)count * EVENT_LOG_ENTRY_SIZE, whileWaiting);
+	log->head = (uint8_t)((log->head + count) % EVENT_LOG_ENTRIES);
+	log->stored = (log->stored + count > EVENT_LOG_ENTRIES) ? EVENT_LOG_ENTRIES : (log->stored + count);
+	for (i = count; i < log->pending; i++) {
+		for (j = 0; j < EVENT_LOG_ENTRY_SIZE; j++) {
+			log->pendingEntry[i - count][j] = log->pendingEntry[i][j];
+		}
+	}
+	log->pending = log->pending - count;
+	return err;
+}
+
+/*
+=======================================================================================
+Method name:  EventLog_read()
+
+Originator:
+
+Description:
+	Copies the newest maxEntries events, oldest first, to pDest: the entries in
+	NFC memory followed by those still in the RAM buffer. Returns the number of
+	entries copied. The NFC must not be busy.
+
+Resources:	NFC over I2C
+
+=======================================================================================
+History:
+*-----*-------------*---------------------------------------------------*--------------
+1.00	10-16-2026	Original Code
+---------------------------------------------------------------------------------------
+*/
+uint8_t EventLog_read(EventLog_STYP *log, uint8_t *pDest, uint8_t maxEntries) {
+	uint8_t i;
+	uint8_t j;
+	uint8_t fromRam;
+	uint8_t fromNfc;
+	uint8_t entry;
+	uint8_t run;
+
+	fromRam = (log->pending < maxEntries) ? log->pending : maxEntries;
+	fromNfc = ((maxEntries - fromRam) < log->stored) ? (maxEntries - fromRam) : log->stored;
+	entry = (uint8_t)((log->head + EVENT_LOG_ENTRIES - fromNfc) % EVENT_LOG_ENTRIES);
+	for (i = 0; i < fromNfc; i = i + run) {
+		run = fromNfc - i;
+		if (run > (EVENT_LOG_ENTRIES - entry)) {
+			run = EVENT_LOG_ENTRIES - entry;	// Ring wraps, read the rest from the start
+		}
+		NFC_SequentialRead(NFC_EVENT_LOG_OFFSET + ((uint16_t)entry * EVENT_LOG_ENTRY_SIZE), run * EVENT_LOG_ENTRY_SIZE, pDest);
+		pDest = pDest + (run * EVENT_LOG_ENTRY_SIZE);
+		entry = 0;
+	}
+	for (i = log->pending - fromRam; i < log->pending; i++) {
+		for (j = 0; j < EVENT_LOG_ENTRY_SIZE; j++) {
+			*pDest++ = log->pendingEntry[i][j];
+		}
+	}
+	return fromNfc + fromRam;
+}
+
+/*
+=======================================================================================
+Method name:  EventLog_readSequencePRIV()
+
+Originator:
+
+Description:
+	Returns the sequence number of an entry in NFC memory.
+
+Resources:	NFC over I2C
+
+=======================================================================================
+History:
+*-----*-------------*---------------------------------------------------*--------------
+1.00	10-16-2026	Original Code
+---------------------------------------------------------------------------------------
+*/
+static uint16_t EventLog_readSequencePRIV(uint8_t entry) {
+	uint8_t data[2];
+
+	NFC_SequentialRead(NFC_EVENT_LOG_OFFSET + ((uint16_t)entry * EVENT_LOG_ENTRY_SIZE), 2, data);
+	return ((uint16_t)data[0] << 8) | data[1];
+}
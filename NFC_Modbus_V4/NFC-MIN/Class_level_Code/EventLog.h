@@ -0,0 +1,75 @@
+/*=====================================================================================
+File name:    EventLog.h
+
+Originator:
+
+Description:	Append only event log kept in a ring of EVENT_LOG_ENTRIES entries
+				from NFC_EVENT_LOG_OFFSET to the top of NFC memory. Events are added
+				to a small RAM buffer and written to the NFC by the Scheduler when it
+				has no other write to do, one NFC page per entry, so adding an event
+				never waits for the NFC.
+				The master reads the log with FC24 Read FIFO Queue.
+
+Multi-Instance: No
+
+Class Methods:
+				void EventLog_init(EventLog_STYP *log);		// Called from MyMain_systemInit()
+				void EventLog_add(EventLog_STYP *log, uint8_t code, uint8_t data);
+				bool EventLog_pending(EventLog_STYP *log);
+				uint8_t EventLog_flush(EventLog_STYP *log, NFC_STYP *nfc, void (*whileWaiting)(void));
+				uint8_t EventLog_read(EventLog_STYP *log, uint8_t *pDest, uint8_t maxEntries);
+Peripheral Resources:
+				NFC over I2C
+IoTranslate requirements:
+
+Other requirements:
+				Entry is one NFC page: sequence number high, low, event code, data.
+				The entry after the newest one is found at power up from the break
+				in the sequence numbers.
+=======================================================================================
+ History:
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	New File
+1.01	10-16-2026	I2C error data 0 is any Modbus write
+---------------------------------------------------------------------------------------
+*/
+
+#ifndef EVENTLOG_H_
+#define EVENTLOG_H_
+
+#include "NFC.h"
+
+#define EVENT_LOG_ENTRY_SIZE		BYTES_IN_PAGE		// One NFC page per entry
+#define EVENT_LOG_ENTRIES			((NFC_MEM_SIZE - NFC_EVENT_LOG_OFFSET) / EVENT_LOG_ENTRY_SIZE)
+#define EVENT_LOG_PENDING			8					// Entries buffered in RAM until written
+#define EVENT_LOG_REGS_PER_ENTRY	(EVENT_LOG_ENTRY_SIZE / 2)
+#define EVENT_LOG_FIFO_ENTRIES		15					// Newest entries read with FC24, 31 registers at most
+
+// Event codes
+enum {
+	EVENT_LOG_POWER_UP = 1,				// Data 0
+	EVENT_LOG_PRODUCT_INFO,				// FC70 product info stored, data is low byte of config code
+	EVENT_LOG_BROADCAST,				// Broadcast block stored, data is block number
+	EVENT_LOG_COMM_TIMEOUT,				// No Modbus request for a second, data is baudSelect
+	EVENT_LOG_I2C_ERROR,				// NFC did not acknowledge a write, data is event code of the write, 0 = Modbus write
+	EVENT_LOG_OVERFLOW,					// RAM buffer was full, data is number of events lost
+};
+
+typedef struct{
+	uint8_t head;						// Next NFC entry written, 0 to EVENT_LOG_ENTRIES - 1
+	uint8_t stored;						// Entries in NFC memory, up to EVENT_LOG_ENTRIES
+	uint16_t sequence;					// Sequence number of next entry added
+	uint8_t pending;					// Entries in pendingEntry[] not written yet
+	uint8_t pendingEntry[EVENT_LOG_PENDING][EVENT_LOG_ENTRY_SIZE];
+}EventLog_STYP;
+
+#define EVENT_LOG_DEFAULTS	{0,0,0,0,{{0}}}
+
+//Public Methods
+void EventLog_init(EventLog_STYP *log);
+void EventLog_add(EventLog_STYP *log, uint8_t code, uint8_t data);
+bool EventLog_pending(EventLog_STYP *log);
+uint8_t EventLog_flush(EventLog_STYP *log, NFC_STYP *nfc, void (*whileWaiting)(void));
+uint8_t EventLog_read(EventLog_STYP *log, uint8_t *pDest, uint8_t maxEntries);
+
+#endif /* EVENTLOG_H_ */
@@ -50,39 +50,214 @@ Resources:
 1.14	05-10-2021	_getProductInfoPRIV() 1.01						 Anish Venkataraman
 					_storeProductInfoPRIV() 1.03
 					deleted productInfoNVM.h reference and
+1.15	10-16-2026	MinSlave_serviceRx() 1.00						
+					MinSlave_manageMessages() 1.04
+1.16	10-16-2026	MinSlave_sendReplyPRIV() 1.01
+1.17	10-16-2026	MinSlave_init() 1.02, MinSlave_manageMessages() 1.05
+					ModbusSlave_writeOneRegisterPRIV() 1.04
+					ModbusSlave_replyRegisterRequestPRIV() 1.06
+					MinSlave_writeSlaveRegisterPRIV() 1.00
+					Tx line enabled when reply turnaround elapsed
+1.18	10-16-2026	MinSlave_sendReplyPRIV() 1.02 appends the CRC, removed
+					get_crc_16() from all reply methods
+1.19	10-16-2026	MinSlave_manageMessages() 1.06, MinSlave_releaseFrame() 1.00
+					ModbusSlave_writeRegistersPRIV() 1.09
+					MinSlave_writeRegistersPRIV() 1.08
+					ModbusSlave_replyRegisterRequestPRIV() 1.07
+					MinSlave_storeProductInfoPRIV() 1.04
+					MinSlave_getProductInfoPRIV() 1.02
+					FC16/FC70 data used in place in the frame buffer
+1.20	10-16-2026	MinSlave_manageMessages() 1.07, MinSlave_releaseFrame() 1.01
+					Messages taken from MinUart frame slots through pRxFrame
+1.21	10-16-2026	MinSlave_init() 1.03, MinSlave_manageMessages() 1.08
+					Added functionTable[] function code descriptor table.
+					Removed unused MinSlave_writeOneRegisterPRIV(),
+					MinSlave_writeRegistersPRIV(), MinSlave_replyRegisterRequestPRIV()
+					and ModbusSlave_slavePollPRIV()
+1.22	10-16-2026	MinSlave_manageMessages() 1.09, MinSlave_releaseFrame() 1.02
+					ModbusSlave_writeOneRegisterPRIV() 1.05
+					ModbusSlave_writeRegistersPRIV() 1.10
+					ModbusSlave_replyRegisterRequestPRIV() 1.08
+					MinSlave_storeProductInfoPRIV() 1.05
+					MinSlave_getProductInfoPRIV() 1.03
+					Added MinSlave_nfcBusyPRIV() and MinSlave_sendExceptionPRIV(),
+					exception 06 while the NFC is busy, 05 for long NFC writes
+1.23	10-16-2026	MinSlave_manageMessages() 1.10, MinSlave_discoverPRIV() 1.02
+					ModbusSlave_writeOneRegisterPRIV() 1.06
+					ModbusSlave_writeRegistersPRIV() 1.11
+					ModbusSlave_replyRegisterRequestPRIV() 1.09
+					MinSlave_storeProductInfoPRIV() 1.06
+					MinSlave_getProductInfoPRIV() 1.04
+					Added MinSlave_nfcAddressOkPRIV(), exceptions 01/02/03
+					for unknown function, bad address and bad quantity
+1.24	10-16-2026	MinSlave_manageMessages() 1.11, MinSlave_sendExceptionPRIV() 1.01
+					ModbusSlave_replyRegisterRequestPRIV() 1.10
+					Added ModbusSlave_replyInputRegistersPRIV() FC04,
+					ModbusSlave_readWriteRegistersPRIV() FC23,
+					MinSlave_checkRegistersPRIV() and MinSlave_readRegistersPRIV()
+1.25	10-16-2026	Added ModbusSlave_readDeviceIdPRIV() FC43/14 Read Device
+					Identification and its deviceIdTable[] objects
+1.26	10-16-2026	MinSlave_manageMessages() 1.12, MinSlave_sendExceptionPRIV() 1.02
+					ModbusSlave_replyInputRegistersPRIV() 1.01
+					Added ModbusSlave_diagnosticsPRIV() FC08,
+					ModbusSlave_commEventCounterPRIV() FC11,
+					ModbusSlave_commEventLogPRIV() FC12 and comm event log
+1.27	10-16-2026	Added ModbusSlave_maskWriteRegisterPRIV() FC22
+1.28	10-16-2026	Added ModbusSlave_readFifoQueuePRIV() FC24 event log
+1.29	10-16-2026	MinSlave_sendReplyPRIV() 1.03
+					ModbusSlave_replyRegisterRequestPRIV() 1.11
+					Added MinSlave_replyStartPRIV(), MinSlave_replyBytePRIV() and
+					MinSlave_replyEndPRIV(), FC03 NFC data streamed to the UART
+1.30	10-16-2026	ModbusSlave_writeOneRegisterPRIV() 1.07
+					ModbusSlave_writeRegistersPRIV() 1.12
+					ModbusSlave_maskWriteRegisterPRIV() 1.01
+					NFC writes taken into write back pages with NFC_bufferWrite()
+1.31	10-16-2026	MinSlave_checkRegistersPRIV() 1.01, MinSlave_readRegistersPRIV() 1.01
+					ModbusSlave_replyRegisterRequestPRIV() 1.12
+					MinSlave_getProductInfoPRIV() 1.05
+					Added MinSlave_nfcReadBusyPRIV() and MinSlave_replyNfcBytePRIV(),
+					reads return data of NFC writes not done yet
+1.32	10-16-2026	MinSlave_writeSlaveRegisterPRIV() 1.01
+					ModbusSlave_writeOneRegisterPRIV() 1.08
+					ModbusSlave_writeRegistersPRIV() 1.13
+					ModbusSlave_maskWriteRegisterPRIV() 1.02
+					ModbusSlave_readWriteRegistersPRIV() 1.01
+					MinSlave_storeProductInfoPRIV() 1.07
+					Added MinSlave_putExceptionPRIV(), NFC write policy registers
+					and writes refused by NFC_takeWrite()
+1.33	10-16-2026	ModbusSlave_writeRegistersPRIV() 1.14, broadcast the NFC
+					already holds is dropped
+1.34	10-16-2026	MinSlave_checkRegistersPRIV() 1.02, NFC region digest
+					registers busy until computed
+1.35	10-16-2026	ModbusSlave_readWriteRegistersPRIV() 1.02, write taken with
+					NFC_bufferWrite()
+1.36	10-16-2026	NFC writes checked with NFC_writeAllowed() and counted with
+					NFC_countWrite() once taken, ModbusSlave_writeOneRegisterPRIV() 1.09,
+					ModbusSlave_writeRegistersPRIV() 1.15,
+					ModbusSlave_maskWriteRegisterPRIV() 1.03,
+					ModbusSlave_readWriteRegistersPRIV() 1.03,
+					MinSlave_storeProductInfoPRIV() 1.08
+1.37	10-16-2026	NFC_WRITE_MSEC() counts the pages from the start address,
+					ModbusSlave_writeRegistersPRIV() 1.16,
+					ModbusSlave_readWriteRegistersPRIV() 1.04
+1.38	10-16-2026	Added MinSlave_digestBusyPRIV(), NFC region digests not computed
+					are busy for FC04 and FC67 too, MinSlave_checkRegistersPRIV() 1.03,
+					ModbusSlave_replyInputRegistersPRIV() 1.02, MinSlave_discoverPRIV() 1.03
+1.39	10-16-2026	MinSlave_digestBusyPRIV() 1.01, digest busy while a write to its
+					region is pending
+1.40	10-16-2026	Added MinSlave_streamLeadPRIV(), streamed FC03 reply armed once the
+					rest of the NFC read is shorter than sending what is queued,
+					ModbusSlave_replyRegisterRequestPRIV() 1.13,
+					MinSlave_replyStartPRIV() 1.01, MinSlave_replyBytePRIV() 1.01
+1.41	10-16-2026	ModbusSlave_replyRegisterRequestPRIV() 1.14
 ---------------------------------------------------------------------------------------
  */
 #include "MinSlave.h"
 #include "IoTranslate.h"
 #include "assert.h"
 #include "NFC.h"
+#include "Scheduler.h"
+#include "EventLog.h"
 
 #define EEPBusy		1
 #define EEPFree		0
 
+// Time the Scheduler takes to write length bytes from byte address to the NFC, TIME_10_MSEC
+// wait per page, data need not start on a page boundary
+#define NFC_WRITE_MSEC(address, length)	(((((uint16_t)(address) & (BYTES_IN_PAGE - 1U)) + (uint16_t)(length) + BYTES_IN_PAGE - 1U) / BYTES_IN_PAGE) * TIME_10_MSEC)
+
 extern MinSlave_STYP oMinSlave;
 //Global variables
 extern NFC_STYP oNFC;
+extern EventLog_STYP oEventLog;
 
 // Private Method Prototypes
 static void MinSlave_slavePollPRIV(void);
 static void MinSlave_discoverPRIV(void);
-static void MinSlave_writeOneRegisterPRIV(void);
-static void MinSlave_writeRegistersPRIV(void);
 static uint8_t MinSlave_spSendRegistersPRIV(void);
 static uint8_t MinSlave_spNothingToRespondPRIV(void);
 static void MinSlave_sendReplyPRIV(uint8_t * txBuf, uint8_t txLength);
-static void MinSlave_replyRegisterRequestPRIV(void);
+static void MinSlave_replyStartPRIV(void);
+static void MinSlave_replyBytePRIV(uint8_t data);
+static void MinSlave_replyEndPRIV(void);
 static void MinSlave_storeProductInfoPRIV(void);
 static void MinSlave_getProductInfoPRIV(void);
 
 static void ModbusSlave_replyRegisterRequestPRIV(void);
 static void ModbusSlave_writeOneRegisterPRIV(void);
 static void ModbusSlave_writeRegistersPRIV(void);
-
-
+static void ModbusSlave_replyInputRegistersPRIV(void);
+static void ModbusSlave_readWriteRegistersPRIV(void);
+static void ModbusSlave_readDeviceIdPRIV(void);
+static void ModbusSlave_maskWriteRegisterPRIV(void);
+static void ModbusSlave_readFifoQueuePRIV(void);
+static void ModbusSlave_diagnosticsPRIV(void);
+static void ModbusSlave_commEventCounterPRIV(void);
+static void ModbusSlave_commEventLogPRIV(void);
+static uint8_t MinSlave_receiveEventPRIV(void);
+static uint8_t MinSlave_sendEventPRIV(uint8_t exceptionCode);
+static void MinSlave_logEventPRIV(uint8_t event);
+static uint8_t MinSlave_putHexPRIV(uint8_t *pDest, uint16_t value, uint8_t digits);
+static uint8_t MinSlave_getFirmwareRevisionPRIV(uint8_t *pDest);
+static uint8_t MinSlave_getConfigCodePRIV(uint8_t *pDest);
+static uint8_t MinSlave_getHardwareRevisionPRIV(uint8_t *pDest);
+static uint8_t MinSlave_writeSlaveRegisterPRIV(uint16_t reg, uint16_t data);
+static uint8_t MinSlave_putExceptionPRIV(uint8_t result);
+static bool MinSlave_nfcBusyPRIV(void);
+static bool MinSlave_nfcReadBusyPRIV(void);
+static void MinSlave_replyNfcBytePRIV(uint8_t data);
+static uint8_t MinSlave_streamLeadPRIV(uint16_t address, uint8_t length);
+static bool MinSlave_nfcAddressOkPRIV(uint16_t registerNumber, uint16_t length, uint8_t access);
+static uint8_t MinSlave_checkRegistersPRIV(uint16_t registerNumber, uint8_t quantity, uint8_t access);
+static bool MinSlave_digestBusyPRIV(uint16_t reg, uint16_t quantity);
+static void MinSlave_readRegistersPRIV(uint16_t registerNumber, uint8_t quantity, uint8_t *pDest);
+static void MinSlave_sendExceptionPRIV(uint8_t exceptionCode);
+
+// Function code descriptor table, indexed by function code. MinUart_serviceRx() frames the
+// request from it and MinSlave_manageMessages() calls the handler. To support another
+// function code add its entry here.
+static const __flash MinFunction_STYP functionTable[MODBUS_FUNCTION_CODES] = {
+//									lengthIndex						lengthAdd					minLength					maxLength					broadcastOK	handler
+	[MODBUS_FC03] =					{0,								0,							NUMBER_REQUEST_BYTES_FC03,	NUMBER_REQUEST_BYTES_FC03,	FALSE,		ModbusSlave_replyRegisterRequestPRIV},	// Read Holding Registers
+	[MODBUS_FC04] =					{0,								0,							NUMBER_REQUEST_BYTES_FC04,	NUMBER_REQUEST_BYTES_FC04,	FALSE,		ModbusSlave_replyInputRegistersPRIV},	// Read Input Registers, slave registers and counters
+	[MODBUS_FC06] =					{0,								0,							NUMBER_REQUEST_BYTES_FC06,	NUMBER_REQUEST_BYTES_FC06,	FALSE,		ModbusSlave_writeOneRegisterPRIV},		// Write 1 Holding Register
+	[MODBUS_FC08] =					{0,								0,							NUMBER_REQUEST_BYTES_FC08,	NUMBER_REQUEST_BYTES_FC08,	FALSE,		ModbusSlave_diagnosticsPRIV},			// Diagnostics, echo and counters
+	[MODBUS_FC11] =					{0,								0,							NUMBER_REQUEST_BYTES_FC11,	NUMBER_REQUEST_BYTES_FC11,	FALSE,		ModbusSlave_commEventCounterPRIV},		// Get Comm Event Counter
+	[MODBUS_FC12] =					{0,								0,							NUMBER_REQUEST_BYTES_FC12,	NUMBER_REQUEST_BYTES_FC12,	FALSE,		ModbusSlave_commEventLogPRIV},			// Get Comm Event Log
+	[MODBUS_FC16] =					{MODBUS_FC16_BYTES_TO_RX_INDEX,	FIXED_REQUEST_BYTES_FC16,	NUMBER_REQUEST_BYTES_FC16,	MAX_REQUEST_BYTES_FC16,		TRUE,		ModbusSlave_writeRegistersPRIV},		// Master broadcast blocks or write to NFC
+	[MODBUS_FC22] =					{0,								0,							NUMBER_REQUEST_BYTES_FC22,	NUMBER_REQUEST_BYTES_FC22,	FALSE,		ModbusSlave_maskWriteRegisterPRIV},		// Mask Write Register, read-modify-write
+	[MODBUS_FC23] =					{MODBUS_FC23_BYTES_TO_RX_INDEX,	FIXED_REQUEST_BYTES_FC23,	MIN_REQUEST_BYTES_FC23,		MAX_REQUEST_BYTES_FC23,		FALSE,		ModbusSlave_readWriteRegistersPRIV},	// Write NFC then read registers
+	[MODBUS_FC24] =					{0,								0,							NUMBER_REQUEST_BYTES_FC24,	NUMBER_REQUEST_BYTES_FC24,	FALSE,		ModbusSlave_readFifoQueuePRIV},			// Read FIFO Queue, event log
+	[MODBUS_FC43] =					{0,								0,							NUMBER_REQUEST_BYTES_FC43,	NUMBER_REQUEST_BYTES_FC43,	FALSE,		ModbusSlave_readDeviceIdPRIV},			// Read Device Identification (MEI type 14)
+	[MODBUS_FC65_SLAVE_POLL] =		{0,								0,							NUMBER_REQUEST_BYTES_FC65,	NUMBER_REQUEST_BYTES_FC65,	FALSE,		MinSlave_slavePollPRIV},				// Reply with one of several slave poll responses
+	[MODBUS_FC67_DISCOVER] =		{0,								0,							NUMBER_REQUEST_BYTES_FC67,	NUMBER_REQUEST_BYTES_FC67,	FALSE,		MinSlave_discoverPRIV},					// Subset of FC03
+	[MODBUS_FC69_GET_PRODUCT_INFO] ={0,								0,							NUMBER_REQUEST_BYTES_FC69,	NUMBER_REQUEST_BYTES_FC69,	FALSE,		MinSlave_getProductInfoPRIV},			// Send product info from NFC
+	[MODBUS_FC70_STORE_PRODUCT_INFO] ={MIN_FC70_BYTES_TO_RX_INDEX,	0,							MIN_REQUEST_BYTES_FC70,		MAX_REQUEST_BYTES_FC70,		FALSE,		MinSlave_storeProductInfoPRIV},			// Store product info to NFC
+};
+
+// Read Device Identification (FC43/14) objects in object id order. Served from flash and
+// RAM only, the NFC is not read.
+static const __flash char deviceIdVendorName[] = DEVICE_ID_VENDOR_NAME;
+static const __flash char deviceIdProductCode[] = DEVICE_ID_PRODUCT_CODE;
+static const __flash DeviceIdObject_STYP deviceIdTable[] = {
+//	objectId	pString					getObject
+	{0x00,		deviceIdVendorName,		0},									// VendorName
+	{0x01,		deviceIdProductCode,	0},									// ProductCode
+	{0x02,		0,						MinSlave_getFirmwareRevisionPRIV},	// MajorMinorRevision, firmware VERSION.REVISION.BUILDREVISION
+	{0x05,		0,						MinSlave_getConfigCodePRIV},		// ModelName, MIN_SLAVE_MODEL_CONFIGURATION_CODE
+	{0x80,		0,						MinSlave_getHardwareRevisionPRIV},	// Extended, CURRENT_HW_VERSION.CURRENT_HW_REVISION
+};
+#define DEVICE_ID_OBJECTS	(sizeof(deviceIdTable) / sizeof(deviceIdTable[0]))
 
 static uint8_t txBuf[NFC_MAX_MEM];
+static uint8_t *pRxFrame = 0;		// Message being handled, frame slot taken with MinUart_getFrame()
+static uint8_t requestException = 0;	// Exception raised by the message being handled, 0 = none
+static uint16_t lastOverruns = 0;	// Bus counts at the last receive event, see MinSlave_receiveEventPRIV()
+static uint16_t lastCommErrors = 0;
+static uint16_t replyCrc = 0xFFFF;		// CRC of the reply being queued, see MinSlave_replyStartPRIV()
+static uint8_t replyQueued = 0;			// Characters of the reply queued so far
+static uint8_t replyLead = MIN_SLAVE_REPLY_LEAD;	// Characters queued before the reply is armed
+static uint16_t replyNfcAddress = 0;	// NFC address of the next byte streamed, see MinSlave_replyNfcBytePRIV()
 //lint -e9029	suppress "Mismatched essential type" PC-Lint 9.00k  Bug in PC-Lint does not like subscripts!
 
 // Create data storage slave block data
@@ -90,7 +265,7 @@ static MinSlave_STYP *pMinSlaveSelf = 0;	// On MinSlave_Init() from MyMain.c a p
 // This will be saved here for the MinSlave_GetSlaveData() getter
 // method screens use to request slave parameters.
 
-uint8_t FlagEEPBusy = 0;
+uint8_t FlagEEPBusy = 0;	// EEPBusy while a request handler uses the NFC over I2C
 
 // Represents longest reply string.
 
@@ -108,6 +283,8 @@ Description:	Initialize ainSlave object
  *-------*-----------*---------------------------------------------------*--------------
 1.00	07-10-2019	Initial Write										Tom Van Sistine
 1.01	08-02-2019	Add setting baud rate								Tom Van Sistine
+1.02	10-16-2026	Set reply turnaround from slave register
+1.03	10-16-2026	Give function code descriptor table to MinUart
 ---------------------------------------------------------------------------------------
  */
 
@@ -123,34 +300,97 @@ void MinSlave_init(MinSlave_STYP *minSlave) {
 	pMinSlaveSelf = minSlave;
 
 	// Initialize the class object
+	minSlave->uart.pFunctionTable = functionTable;
 	MinUart_init(&minSlave->uart);
+	MinUart_setTurnaround(&minSlave->uart, minSlave->slaveRegisters[MIN_SLAVE_TURNAROUND_USEC_RNUM]);
 
 	// Initialize back to default if something went wrong
 	minRxEnable();
 }
 
+/*
+=======================================================================================
+Method name:    MinSlave_serviceRx()
+
+Originator:   	
+
+Description:  	Called by driver_isr.c's USART0_RXC ISR when a byte comes in from the
+				Master. Calls MinUart_serviceRx() for each character in the receive
+				buffer. Only framing is done here, when a complete message with a good
+				CRC is found its frame slot is set READY and MinSlave_manageMessages()
+				handles it from the main loop.
+
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Broke out of MinSlave_manageMessages()
+---------------------------------------------------------------------------------------
+ */
+void MinSlave_serviceRx(void) {
+
+	// If pointer to itself has not been initialized, return.
+	if (pMinSlaveSelf == 0) {
+		return;
+	}
+	// Poll UART Rx buffer for characters and call MinUart_ServiceRx() for each character
+	// received until buffer is empty.
+	while (HardwareUart_GetCharsInRxBuf() > (uint16_t) 0) {
+		MinUart_serviceRx(&pMinSlaveSelf->uart);
+	}
+}
+
 /*
 =======================================================================================
 Method name:    MinSlave_manageMessages()
 
 Originator:   	Tom Van Sistine
 
-Description:  	Called by Events.c's OnRxChar() when a byte comes in from MIN Master.
-				Calls MinUart_ServiceRx() to handle incoming byte.
-				If an incoming message is ready, then process it. This may include
+Description:  	Called from MyMain_main() loop.
+				If an incoming message is ready (frame slot set READY by
+				MinSlave_serviceRx() in the receive ISR), then process it. This may include
 				sending a reply or just taking an action based on sent data or command.
+				The slot is released only after the message is handled, while the next
+				message is received into the other slot.
+				If the handler gave the NFC object a pointer into the frame
+				(pHandedOffFrame) the frame is released by the Scheduler instead. Later
+				messages are still handled from the other slot, also from the Scheduler
+				while it waits for an NFC page write, and get exception 06 if they need
+				the NFC before it is written.
+
+				The handler for the function code comes from functionTable[], MinUart
+				has already checked the function code and request length against it.
+				A request with an unknown function code (exception 01) or a length
+				byte out of range (exception 03) is only replied to with the exception.
+				Handlers reply with exception 03 for a bad quantity and 02 for a
+				register outside the slave registers or NFC memory map.
 
 				Messages specify function codes (FCxx) that include:
 
 
 				FC03: Read specified registers at offset for length.
 
+				FC04: Read input registers, slave registers and slave counters.
+
 				FC06: Write single register (i.e. like a setpoint)
 
+				FC08: Diagnostics, return query data, bus and slave counters, clear
+				counters.
+
+				FC11/FC12: Comm event counter and comm event log, the log is the last
+				MIN_SLAVE_EVENT_LOG_SIZE receive and send events kept in RAM.
+
 				FC16: Write Multiple registers i.e. used for Broadcast: Blocks from
 				Master that some or all data needs to be saved, or could be used to
 				configure a slave device like CPAM-MIN
 
+				FC22: Mask write one register, read-modify-write done by the slave.
+
+				FC23: Write NFC registers then read registers in one request.
+
+				FC24: Read FIFO Queue, newest entries of the event log kept in NFC.
+
+				FC43/14: Read Device Identification from flash constants.
+
 				FC 65 Slave Poll Request: The Master permits the slave to initiate a
 				message.
 				These can include broadcasting its block of registers, sending a setpoint
@@ -180,207 +420,372 @@ Description:  	Called by Events.c's OnRxChar() when a byte comes in from MIN Mas
 1.02	08-07-2019	Refactored to break out command replies				Tom Van Sistine
 1.03	07-07-2020	Added get and store method for product info		 Anish Venkataraman
 					FC69 and FC70	
+1.04	10-16-2026	Moved out of receive ISR to main loop, receive
+					buffer drained in MinSlave_serviceRx()
+1.05	10-16-2026	Removed 2 msec delay, reply is held by the UART
+					until the turnaround timer elapsed
+1.06	10-16-2026	Frame not released when handed off to NFC write
+1.07	10-16-2026	Message taken from MinUart frame slot
+1.08	10-16-2026	Handler called from function code descriptor table
+1.09	10-16-2026	Messages handled while a frame is handed off to NFC
+					write, can be called from the Scheduler write wait
+1.10	10-16-2026	Exception reply for request MinUart could not frame
+1.11	10-16-2026	Count requests handled
+1.12	10-16-2026	Log comm events, count requests completed and
+					broadcasts not replied to
 ---------------------------------------------------------------------------------------
  */
 
 
 
 void MinSlave_manageMessages(void) {
+	void (*handler)(void);
+	uint8_t exceptionCode;
 
 	// If pointer to itself has not been initialized, return.
 	if (pMinSlaveSelf == 0) {
 		return;
 	}
-	// Poll UART Rx buffer for characters and call MinUart_ServiceRx() for each character
-	// received until buffer is empty.
-	while (HardwareUart_GetCharsInRxBuf() > (uint16_t) 0) {
-		MinUart_serviceRx(&pMinSlaveSelf->uart);
-	}
 	// Check if a packet of data from Master device (found in AinUart_ServiceRx()) is ready to process.
-	if (pMinSlaveSelf->uart.processPacketFlag == FALSE) {
+	pRxFrame = MinUart_getFrame(&pMinSlaveSelf->uart, &exceptionCode);
+	if (pRxFrame == 0) {
 		return;
 	}
 	pMinSlaveSelf->validCommunicationReceivedFLG = TRUE; //Signal communications timer to reset.
 
-	// Packet is finished and checksum is OK
-	pMinSlaveSelf->uart.processPacketFlag = FALSE;
-
 	// Reset no communications timer (if somehow no communications for a while Scheduler will reset for discover baud)
 	pMinSlaveSelf->communicationTimeoutCNTR = ONE_SECOND_TIME;
+	pMinSlaveSelf->counters[MIN_SLAVE_MESSAGE_CNUM]++;
+	MinSlave_logEventPRIV(MinSlave_receiveEventPRIV());
+	requestException = 0;
 
-	MinTurnAroundDelayMAC();  // 2 msec delay before reply to give chance for master to turn off it TxEnable.
+	// MinUart_serviceRx() sets exceptionCode for function codes without a handler in functionTable[]
+	if (exceptionCode != 0) {
+		MinSlave_sendExceptionPRIV(exceptionCode);
+	}
+	else {
+		handler = functionTable[pRxFrame[MODBUS_FUNCTION_CODE_INDEX]].handler;
+		if (handler != 0) {
+			handler();
+		}
+	}
 
-	switch (pMinSlaveSelf->uart.functionCode) {
+	if (pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST) {
+		pMinSlaveSelf->counters[MIN_SLAVE_NO_RESPONSE_CNUM]++;
+	}
+	else {
+		MinSlave_logEventPRIV(MinSlave_sendEventPRIV(requestException));
+	}
+	// Comm event counter does not count exceptions or the event counter requests themselves
+	if ((requestException == 0) &&
+		(pRxFrame[MODBUS_FUNCTION_CODE_INDEX] != MODBUS_FC11) &&
+		(pRxFrame[MODBUS_FUNCTION_CODE_INDEX] != MODBUS_FC12)) {
+		pMinSlaveSelf->eventCount++;
+	}
 
-		//case MIN_FC03:     				// Requesting one or more Holding Registers. Note: FC03 are always slave specific as it requires reply.
-		//MinSlave_replyRegisterRequestPRIV();
-		
-		case MODBUS_FC03:     				// Requesting one or more Holding Registers. Note: FC03 are always slave specific as it requires reply.
-		ModbusSlave_replyRegisterRequestPRIV();
-		
-		break;
-		
-		case MIN_FC67_DISCOVER:			// Discover is basically the same as FC03 (subset) so share common code
-		MinSlave_discoverPRIV();
-		break;
+	// Packet is handled, release frame for the next message unless NFC write still uses it
+	if (pMinSlaveSelf->pHandedOffFrame != pRxFrame) {
+		MinUart_releaseFrame(&pMinSlaveSelf->uart, pRxFrame);
+	}
+}
 
-		//case MIN_FC06: // Write 1 Holding Slave Register
-		//MinSlave_writeOneRegisterPRIV();
-		//break;
+/*
+=======================================================================================
+Method name:    MinSlave_releaseFrame()
 
-		case MIN_FC06: // Write 1 Holding Slave Register
-		ModbusSlave_writeOneRegisterPRIV();
-		break;
+Originator:   	
 
-		//case MIN_FC16:	// Write Master broadcast blocks or multiple slave registers
-		//MinSlave_writeRegistersPRIV();
-		//break;
-		case MIN_FC16:	// Write Master broadcast blocks or multiple slave registers
-		ModbusSlave_writeRegistersPRIV();
-		break;
+Description:  	Gives the frame slot handed off to the NFC write back to the receive
+				ISR so a later message can be received into it. Called by the Scheduler
+				when the NFC write of FC16/FC70 data that was left in the frame buffer
+				is done.
 
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+1.01	10-16-2026	Release MinUart frame slot
+1.02	10-16-2026	Only releases the frame handed off to NFC write
+---------------------------------------------------------------------------------------
+ */
+void MinSlave_releaseFrame(void) {
 
-		case MIN_FC65_SLAVE_POLL:
-		MinSlave_slavePollPRIV(); // Reply with one of several possible slave poll responses.
-		break;
+	if ((pMinSlaveSelf == 0) || (pMinSlaveSelf->pHandedOffFrame == 0)) {
+		return;
+	}
+	MinUart_releaseFrame(&pMinSlaveSelf->uart, pMinSlaveSelf->pHandedOffFrame);
+	pMinSlaveSelf->pHandedOffFrame = 0;
+}
 
-		case MIN_FC69_GET_PRODUCT_INFO:
-		//send contents from NFC requested by Master
-		MinSlave_getProductInfoPRIV();
-		break;
+/*
+=======================================================================================
+Method name:    MinSlave_nfcBusyPRIV()
 
-		case MIN_FC70_STORE_PRODUCT_INFO:
-		//store contents to NFC sent by Master
-		MinSlave_storeProductInfoPRIV();
-		break;
+Originator:   	
 
-		default:
-		break;
+Description:  	Returns TRUE when a request that uses the NFC can not be handled now,
+				an NFC write is pending or in progress (see NFC_isBusy()) or the NFC
+				is used by the request handler.
+
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+---------------------------------------------------------------------------------------
+ */
+static bool MinSlave_nfcBusyPRIV(void) {
+
+	return ((FlagEEPBusy == EEPBusy) || NFC_isBusy(&oNFC));
+}
+
+/*
+=======================================================================================
+Method name:    MinSlave_nfcReadBusyPRIV()
+
+Originator:   	
+
+Description:  	Returns TRUE when a request that only reads the NFC can not be handled
+				now, the NFC is writing a page (see NFC_isWriting()) or is used by the
+				request handler. Writes flagged for the Scheduler are read with
+				NFC_pendingByte() instead of waiting for them.
+
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+---------------------------------------------------------------------------------------
+ */
+static bool MinSlave_nfcReadBusyPRIV(void) {
+
+	return ((FlagEEPBusy == EEPBusy) || NFC_isWriting(&oNFC));
+}
+
+/*
+=======================================================================================
+Method name:    MinSlave_nfcAddressOkPRIV()
+
+Originator:   	
+
+Description:  	Returns TRUE when length bytes from Modbus register registerNumber are
+				in NFC memory and the memory map allows the access (NFC_REGION_READ
+				and/or NFC_REGION_WRITE), see NFC_checkAccess().
+
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+---------------------------------------------------------------------------------------
+ */
+static bool MinSlave_nfcAddressOkPRIV(uint16_t registerNumber, uint16_t length, uint8_t access) {
+
+	if (registerNumber >= (NFC_MEM_SIZE / MODBUS_BYTES_PER_REG)) {
+		return FALSE;
+	}
+	return NFC_checkAccess(registerNumber * MODBUS_BYTES_PER_REG, length, access);
+}
+
+/*
+=======================================================================================
+Method name:    MinSlave_checkRegistersPRIV()
+
+Originator:   	
+
+Description:  	Checks quantity holding registers from registerNumber can be accessed
+				(NFC_REGION_READ or NFC_REGION_WRITE for NFC memory) now. Returns 0 if
+				they can, otherwise the Modbus exception to reply with:
+				MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS outside the slave registers or
+				NFC memory map, MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY if the NFC is busy,
+				for NFC_REGION_READ only while it writes a page.
+				Slave registers are only checked for read, busy while an NFC region
+				digest read is not computed yet.
+
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+1.01	10-16-2026	Read not busy while an NFC write is only pending
+1.02	10-16-2026	Busy for a region digest not computed yet
+1.03	10-16-2026	Digest check moved to MinSlave_digestBusyPRIV()
+---------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_checkRegistersPRIV(uint16_t registerNumber, uint8_t quantity, uint8_t access) {
+	uint16_t reg;
+
+	if (registerNumber >= MODBUS_SLAVE_REGISTER_BASE) {	//slave registers, not NFC memory
+		reg = registerNumber - MODBUS_SLAVE_REGISTER_BASE;
+		if ((reg + quantity) > MIN_SLAVE_NUMBER_OF_REGISTERS) {
+			return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+		}
+		if (MinSlave_digestBusyPRIV(reg, quantity)) {
+			return MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY;
+		}
+	}
+	else if (!MinSlave_nfcAddressOkPRIV(registerNumber, (uint16_t)quantity * MODBUS_BYTES_PER_REG, access)) {
+		return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+	}
+	else if ((access == NFC_REGION_READ) ? MinSlave_nfcReadBusyPRIV() : MinSlave_nfcBusyPRIV()) {
+		return MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY;
+	}
+	return 0;
+}
+
+/*
+=======================================================================================
+Method name:    MinSlave_digestBusyPRIV()
+
+Originator:   	
+
+Description:  	Returns TRUE when quantity slave registers from reg (not offset by
+				MODBUS_SLAVE_REGISTER_BASE) hold an NFC region digest that is not
+				computed yet or does not hold a pending write to its region, see
+				NFC_digestReady(). The register is then answered busy by every
+				function code that reads slave registers.
+
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Broke out of MinSlave_checkRegistersPRIV()
+1.01	10-16-2026	Busy while a write to the region is pending
+---------------------------------------------------------------------------------------
+ */
+static bool MinSlave_digestBusyPRIV(uint16_t reg, uint16_t quantity) {
+	uint8_t region;
+
+	for (region = 0; region < NFC_REGIONS; region++) {
+		if ((reg <= (MIN_SLAVE_REGION0_DIGEST_RNUM + region)) && ((MIN_SLAVE_REGION0_DIGEST_RNUM + region) < (reg + quantity)) &&
+			!NFC_digestReady(&oNFC, region)) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*
+=======================================================================================
+Method name:    MinSlave_readRegistersPRIV()
+
+Originator:   	
+
+Description:  	Reads quantity holding registers from registerNumber, high byte first,
+				to pDest. Slave registers at MODBUS_SLAVE_REGISTER_BASE, NFC memory
+				below it. Checked with MinSlave_checkRegistersPRIV() first. NFC
+				writes not done yet are included, see NFC_overlayPending().
+
+=======================================================================================
+ History: (Identify changes in this method)	
+ *-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Broke out of ModbusSlave_replyRegisterRequestPRIV()
+1.01	10-16-2026	Pending NFC writes included
+---------------------------------------------------------------------------------------
+ */
+static void MinSlave_readRegistersPRIV(uint16_t registerNumber, uint8_t quantity, uint8_t *pDest) {
+	uint8_t i;
+
+	if (registerNumber >= MODBUS_SLAVE_REGISTER_BASE) {	//slave registers, not NFC memory
+		registerNumber = registerNumber - MODBUS_SLAVE_REGISTER_BASE;
+		for (i = 0; i < quantity; i++, registerNumber++) {
+			*pDest++ = (uint8_t)(pMinSlaveSelf->slaveRegisters[registerNumber] >> 8);
+			*pDest++ = (uint8_t)(pMinSlaveSelf->slaveRegisters[registerNumber] & 0xFF);
+		}
+	}
+	else {
+		FlagEEPBusy = EEPBusy;
+		NFC_SequentialRead(registerNumber * MODBUS_BYTES_PER_REG, quantity * MODBUS_BYTES_PER_REG, pDest);	//Read straight into pDest
+		NFC_overlayPending(&oNFC, registerNumber * MODBUS_BYTES_PER_REG, pDest, quantity * MODBUS_BYTES_PER_REG);
+		FlagEEPBusy = EEPFree;
 	}
 }
 
 /*
  ========================================================================================
- Method name:  MinSlave_discover()
+ Method name:  MinSlave_sendExceptionPRIV()
 
- Originator:   Tom Van Sistine
+ Originator:   
 
  Description:
+		Replies to the request being handled with a Modbus exception:
+		SlaveAddress, FC | MODBUS_EXCEPTION_FLAG, exception code.
+		There is no reply to a broadcast.
 
- 	 	 Handles Discovery command reply
  Resources:
 
  ========================================================================================
  History:
  *-------*-----------*---------------------------------------------------*---------------
- 1.00    08-07-2019  Original code broke out MinSlave_manageMessages()   Tom Van Sistine
- 1.01	 11-04-2019  Added code to read from NFC and append it to the  Anish Venkataraman
-					 MIN_SLAVE_MODEL_CONFIGURATION_CODE.
+ 1.00    10-16-2026  Original code
+ 1.01    10-16-2026  Count exception replies
+ 1.02    10-16-2026  Exception kept for the comm event log
  ----------------------------------------------------------------------------------------
  */
-static void MinSlave_discoverPRIV(void) {
-
-	uint8_t i;							// Generic index variable used where needed
-	uint16_t * registerDataPointer;		// Generic point to either master or slave registers depending on which command processed.
-	uint8_t * dataPtr;
-	uint16_t crc;
-	uint8_t txLength;
-	//uint16_t config = 0;
-	// Setup reply
-	txBuf[MIN_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
-	txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC67_DISCOVER;                    			// Function code
-	txBuf[MIN_FC03_BYTES_REPLY_INDEX] = pMinSlaveSelf->uart.rxBuffer[MIN_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG;
-	// Get requested registers
-
-	// Set source pointer to slave data
-	registerDataPointer = &pMinSlaveSelf->slaveRegisters[pMinSlaveSelf->uart.rxBuffer[MIN_FC03_START_ADDR_INDEX]];
+static void MinSlave_sendExceptionPRIV(uint8_t exceptionCode) {
 
-	// Set destination pointer to txBuf
-	dataPtr = &txBuf[MIN_FC03_DATA_START];
-	for (i = 0; i < pMinSlaveSelf->uart.rxBuffer[MIN_FC03_NUM_REG_INDEX]; i++) {
-		*dataPtr++ = (uint8_t)(*registerDataPointer >> 8);		// Data High
-		*dataPtr++ = (uint8_t) (*registerDataPointer++ & 0xFF);	// Data Low
+	requestException = exceptionCode;
+	if (pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST) {
+		return;
 	}
-
-	crc = get_crc_16 (0xFFFF, txBuf, MIN_FC03_START_ADDR_INDEX + (i * MIN_BYTES_PER_REG));         // Calculate the CRC to send with reply
-	*dataPtr++ = (uint8_t) (crc & 0xff);   // CRCL
-	*dataPtr = (uint8_t) (crc >> 8); // CRCH
-	txLength = (MIN_FC03_DATA_START + (pMinSlaveSelf->uart.rxBuffer[MIN_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG) + MIN_CRC_LENGTH);
-
-	// Enable the Tx line
-	minTxEnable();
-	// Send reply
-	MinSlave_sendReplyPRIV(txBuf, txLength);
-
+	pMinSlaveSelf->counters[MIN_SLAVE_EXCEPTION_CNUM]++;
+	if (exceptionCode == MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY) {
+		pMinSlaveSelf->counters[MIN_SLAVE_BUSY_CNUM]++;
+	}
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = pRxFrame[MODBUS_FUNCTION_CODE_INDEX] | MODBUS_EXCEPTION_FLAG;
+	txBuf[MODBUS_EXCEPTION_CODE_INDEX] = exceptionCode;
+	MinSlave_sendReplyPRIV(txBuf, MODBUS_EXCEPTION_REPLY_LENGTH);
 }
 
 /*
  ========================================================================================
- Method name:  MinSlave_writeOneRegisterPRIV()
+ Method name:  MinSlave_discover()
 
  Originator:   Tom Van Sistine
 
  Description:
-		Handles FC06 command to write one register
 
+ 	 	 Handles Discovery command reply
  Resources:
 
  ========================================================================================
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    08-07-2019  Original code broke out MinSlave_manageMessages()   Tom Van Sistine
- 1.01    06-04-2020  Modified the code to write the respective block   Anish Venkataraman
-					 register to NFC key
- 1.02    08-12-2020  Refactored the code to save permission to		   Anish Venkataraman
-					 save register data to NFC key
+ 1.01	 11-04-2019  Added code to read from NFC and append it to the  Anish Venkataraman
+					 MIN_SLAVE_MODEL_CONFIGURATION_CODE.
+ 1.02	 10-16-2026  Exception 02 for registers past the slave registers
+ 1.03	 10-16-2026  Exception 06 for an NFC region digest not computed yet
  ----------------------------------------------------------------------------------------
  */
-static void MinSlave_writeOneRegisterPRIV(void)  {
+static void MinSlave_discoverPRIV(void) {
+
 	uint8_t i;							// Generic index variable used where needed
-	uint16_t data;
+	uint16_t * registerDataPointer;		// Generic point to either master or slave registers depending on which command processed.
 	uint8_t * dataPtr;
-	uint16_t crc;
 	uint8_t txLength;
-	uint16_t address;
-	uint8_t registerNumber;
-	uint8_t block;
-	block = pMinSlaveSelf->uart.rxBuffer[MIN_FC03_BLOCK_INDEX]; //get block info
-	data = (((uint16_t) pMinSlaveSelf->uart.rxBuffer[MIN_FC06_REG_VALH_INDEX]) << 8) + (uint16_t) pMinSlaveSelf->uart.rxBuffer[MIN_FC06_REG_VALl_INDEX]; //get data
-	registerNumber =  pMinSlaveSelf->uart.rxBuffer[MIN_FC03_START_ADDR_INDEX]; //store register number
-	if(block == BLOCK2 || block == BLOCK11 ||block == BLOCK226 ){
-		if(block == BLOCK2){
-			address = BLOCK2_OFFSET + (registerNumber * 2); //address update
-		}
-		else if(block == BLOCK11){
-			address = BLOCK11_OFFSET + (registerNumber * 2);
-		}
-		else{
-			address = BLOCK226_OFFSET + (registerNumber * 2);
-		}
-		NFC_InstantaneousWrite(&oNFC,address,data);//write the data
-		
+	//uint16_t config = 0;
+	if (((uint16_t)pRxFrame[MIN_FC03_START_ADDR_INDEX] + pRxFrame[MIN_FC03_NUM_REG_INDEX]) > MIN_SLAVE_NUMBER_OF_REGISTERS) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
 	}
-	else if (block == MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM) { //save permision to min slave specific register
-		pMinSlaveSelf->slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] = data;
-	}	
-	else {
-		//do nothing
-		
+	if (MinSlave_digestBusyPRIV(pRxFrame[MIN_FC03_START_ADDR_INDEX], pRxFrame[MIN_FC03_NUM_REG_INDEX])) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
 	}
-	// Reply is required for specific slave writing of a register. Reply is same as request for first 6 bytes received
-	dataPtr = &pMinSlaveSelf->uart.rxBuffer[MIN_SLAVE_ADDRESS_INDEX];
+	// Setup reply
+	txBuf[MIN_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC67_DISCOVER;                    			// Function code
+	txBuf[MIN_FC03_BYTES_REPLY_INDEX] = pRxFrame[MIN_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG;
+	// Get requested registers
 
-	for (i = 0; i < MIN_FC_WRITE_REPLY_LENGTH; i++) {
-		txBuf[i] = *dataPtr++;
-	}
+	// Set source pointer to slave data
+	registerDataPointer = &pMinSlaveSelf->slaveRegisters[pRxFrame[MIN_FC03_START_ADDR_INDEX]];
 
-	crc = get_crc_16 (0xFFFF, txBuf, MIN_FC_WRITE_REPLY_LENGTH);         // Calculate the CRC to send with reply slaveAddr, FC, addrH, addrL, dataH, datal
-	txBuf[MIN_FC_CRCL_INDEX] = (uint8_t) (crc & 0xff);             // CRCL
-	txBuf[MIN_FC_CRCH_INDEX] = (uint8_t) (crc >> 8);               // CRCH
-	txLength = MIN_FC_WRITE_REPLY_LENGTH + (uint8_t) MIN_CRC_LENGTH;
+	// Set destination pointer to txBuf
+	dataPtr = &txBuf[MIN_FC03_DATA_START];
+	for (i = 0; i < pRxFrame[MIN_FC03_NUM_REG_INDEX]; i++) {
+		*dataPtr++ = (uint8_t)(*registerDataPointer >> 8);		// Data High
+		*dataPtr++ = (uint8_t) (*registerDataPointer++ & 0xFF);	// Data Low
+	}
 
-	// Enable the Tx line
-	minTxEnable();
+	txLength = (MIN_FC03_DATA_START + (pRxFrame[MIN_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG));
 
 	// Send reply
 	MinSlave_sendReplyPRIV(txBuf, txLength);
@@ -394,7 +799,9 @@ static void MinSlave_writeOneRegisterPRIV(void)  {
  Originator:   Tom Van Sistine
 
  Description:
-		Handles FC06 command to write one register
+		Handles FC06 command to write one register. An NFC register is taken
+		into the write back pages and written by the Scheduler, exception 06
+		when they are full.
 
  Resources:
 
@@ -408,52 +815,71 @@ static void MinSlave_writeOneRegisterPRIV(void)  {
 					 save register data to NFC key
  1.03    10-11-2022  Standard Modbus implemented instead of MIN		   Onkar Raut
 					 					 
+ 1.04    10-16-2026  Write slave registers at MODBUS_SLAVE_REGISTER_BASE
+ 1.05    10-16-2026  Exception 06 when NFC is busy
+ 1.06    10-16-2026  Exception 02 for register that can not be written
+ 1.07    10-16-2026  NFC register written with NFC_bufferWrite()
+ 1.08    10-16-2026  Exception 03 for a bad slave register value, 06 when the
+					 NFC write policy refuses the write
+ 1.09    10-16-2026  NFC write counted for its policy only once taken
  ----------------------------------------------------------------------------------------
  */
 static void ModbusSlave_writeOneRegisterPRIV(void)  {
 	uint8_t i;							// Generic index variable used where needed
 	uint16_t data;
 	uint8_t * dataPtr;
-	uint16_t crc;
 	uint8_t txLength;
 	uint16_t address;
 	uint16_t registerNumber;
 	uint8_t block;
+	uint8_t result;
 	
-	FlagEEPBusy = EEPBusy;
-	
-	block = pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_BLOCK_INDEX]; //get block info
-	data = (((uint16_t) pMinSlaveSelf->uart.rxBuffer[MODBUS_FC06_REG_VALH_INDEX]) << 8) + (uint16_t) pMinSlaveSelf->uart.rxBuffer[MODBUS_FC06_REG_VALl_INDEX]; //get data
-	registerNumber =  pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_START_ADDR_INDEX]; //store register number
+	block = pRxFrame[MODBUS_FC03_BLOCK_INDEX]; //get block info
+	data = (((uint16_t) pRxFrame[MODBUS_FC06_REG_VALH_INDEX]) << 8) + (uint16_t) pRxFrame[MODBUS_FC06_REG_VALl_INDEX]; //get data
+	registerNumber =  pRxFrame[MODBUS_FC03_START_ADDR_INDEX]; //store register number
 	
 
-	registerNumber = (pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_MSB_ADDR_INDEX]);
+	registerNumber = (pRxFrame[MODBUS_FC03_MSB_ADDR_INDEX]);
 	registerNumber = registerNumber << 8;
-	registerNumber = registerNumber | (pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_START_ADDR_INDEX]);
+	registerNumber = registerNumber | (pRxFrame[MODBUS_FC03_START_ADDR_INDEX]);
 //	registerNumber = ((uint16_t)registerNumber - 0x9C40);
 	
 	address = (uint16_t)registerNumber * 2;
 
-	NFC_InstantaneousWrite(&oNFC,address,data);//write the data
+	if (registerNumber >= MODBUS_SLAVE_REGISTER_BASE) {	//slave register, not NFC memory
+		result = MinSlave_writeSlaveRegisterPRIV(registerNumber - MODBUS_SLAVE_REGISTER_BASE, data);
+		if (result != MINSLAVE_PUT_SLAVE_DATA_SUCCESS) {
+			MinSlave_sendExceptionPRIV(MinSlave_putExceptionPRIV(result));
+			return;
+		}
+	}
+	else if (!MinSlave_nfcAddressOkPRIV(registerNumber, MODBUS_BYTES_PER_REG, NFC_REGION_WRITE)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
+	}
+	else if (MinSlave_nfcBusyPRIV() || !NFC_writeAllowed(address, MODBUS_BYTES_PER_REG)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
+	}
+	else if (NFC_bufferWrite(address, &pRxFrame[MODBUS_FC06_REG_VALH_INDEX], MODBUS_BYTES_PER_REG) != NO_WRITE_ERR) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
+	}
+	else {
+		NFC_countWrite(address, MODBUS_BYTES_PER_REG);
+	}
 	// Reply is required for specific slave writing of a register. Reply is same as request for first 6 bytes received
-	dataPtr = &pMinSlaveSelf->uart.rxBuffer[MODBUS_SLAVE_ADDRESS_INDEX];
+	dataPtr = &pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX];
 
 	for (i = 0; i < MODBUS_FC_WRITE_REPLY_LENGTH; i++) {
 		txBuf[i] = *dataPtr++;
 	}
 
-	crc = get_crc_16 (0xFFFF, txBuf, MODBUS_FC_WRITE_REPLY_LENGTH);         // Calculate the CRC to send with reply slaveAddr, FC, addrH, addrL, dataH, datal
-	txBuf[MODBUS_FC_CRCL_INDEX] = (uint8_t) (crc & 0xff);             // CRCL
-	txBuf[MODBUS_FC_CRCH_INDEX] = (uint8_t) (crc >> 8);               // CRCH
-	txLength = MODBUS_FC_WRITE_REPLY_LENGTH + (uint8_t) MODBUS_CRC_LENGTH;
+	txLength = MODBUS_FC_WRITE_REPLY_LENGTH;
 
-	// Enable the Tx line
-	minTxEnable();
 
 	// Send reply
 	MinSlave_sendReplyPRIV(txBuf, txLength);
-	
-	FlagEEPBusy = EEPFree;
 
 }
 
@@ -465,7 +891,11 @@ static void ModbusSlave_writeOneRegisterPRIV(void)  {
 
  Description:
  	 	 Handles write multiple registers (block writes) which can be Master broadcast
- 	 	 blocks (no reply) or multiple slave registers (with reply).
+ 	 	 blocks (no reply) or multiple slave registers (with reply). A write addressed
+		 to the NFC is taken into the write back pages if they have room, else it is
+		 left in the frame buffer for Scheduler_writeInstant(). A write the NFC write
+		 policy refuses is answered busy, or dropped if broadcast. A broadcast block
+		 the NFC already holds (NFC_broadcastUnchanged()) is dropped without any I2C.
 
  Resources:
 
@@ -485,37 +915,66 @@ static void ModbusSlave_writeOneRegisterPRIV(void)  {
  1.06    08-28-2020  Added reply when addressed to NFC				   Anish Venkataraman
  1.07    02-19-2021  Added check for permission to save data		   Anish Venkataraman
  1.08	 08-11-2022	 Actual Modbus implemented in Firmware			   Onkar Raut
+ 1.09	 10-16-2026	 Register data left in frame buffer for NFC write
+ 1.10	 10-16-2026	 Exception 06 when NFC is busy, 05 when the NFC write
+					 takes longer than the response time
+ 1.11	 10-16-2026	 Exception 03 for bad quantity, 02 outside NFC memory
+ 1.12	 10-16-2026	 Write to NFC taken with NFC_bufferWrite() when it fits
+ 1.13	 10-16-2026	 Exception 06 when the NFC write policy refuses the write
+ 1.14	 10-16-2026	 Drop broadcast the NFC already holds
+ 1.15	 10-16-2026	 NFC write counted for its policy only once taken
+ 1.16	 10-16-2026	 NFC write time counts the pages from the start address
  ----------------------------------------------------------------------------------------
  */
 
 static void ModbusSlave_writeRegistersPRIV(void) {
 	uint8_t i;							// Generic index variable used where needed
 	uint8_t txLength;
-	uint16_t crc;
 	uint8_t * dataPtr;
 	uint8_t blockNumber;
 	uint16_t registerNumber;
 	uint8_t dataLength;
-	
-	
-	FlagEEPBusy = EEPBusy;
+	uint16_t quantity;
 	
 	
 
-	registerNumber = (uint16_t)(pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_MSB_ADDR_INDEX]);
+	registerNumber = (uint16_t)(pRxFrame[MODBUS_FC03_MSB_ADDR_INDEX]);
 	registerNumber = (uint16_t)registerNumber << 8;
-	registerNumber = (uint16_t)registerNumber | (pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_START_ADDR_INDEX]);
+	registerNumber = (uint16_t)registerNumber | (pRxFrame[MODBUS_FC03_START_ADDR_INDEX]);
 //	registerNumber = ((uint16_t)registerNumber - 0x9C40);
 		
 
 	
-	dataLength = pMinSlaveSelf->uart.rxBuffer[MODBUS_FC16_BYTES_TO_RX_INDEX]; //length of the data to be written
-	// Initialize source data pointer to start of register data in rxBuffer
-	dataPtr = &pMinSlaveSelf->uart.rxBuffer[MODBUS_FC16_DATA_START_INDEX];	// Set pointer to first incoming register value high byte.
+	dataLength = pRxFrame[MODBUS_FC16_BYTES_TO_RX_INDEX]; //length of the data to be written
+	quantity = ((uint16_t)pRxFrame[MODBUS_FC16_NUM_REG_INDEX - 1] << 8) | pRxFrame[MODBUS_FC16_NUM_REG_INDEX];
+	// Initialize source data pointer to start of register data in the frame
+	dataPtr = &pRxFrame[MODBUS_FC16_DATA_START_INDEX];	// Set pointer to first incoming register value high byte.
+	
+	if ((quantity == 0) || (quantity > MODBUS_FC16_MAX_REGISTERS) || (dataLength != (quantity * MODBUS_BYTES_PER_REG))) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+		return;
+	}
+	if (!MinSlave_nfcAddressOkPRIV(registerNumber, dataLength, NFC_REGION_WRITE)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
+	}
+	// Master broadcasts the same blocks over and over, one already stored is not written
+	if ((pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST) &&
+		NFC_broadcastUnchanged(registerNumber * MODBUS_BYTES_PER_REG, dataPtr, dataLength)) {
+		return;
+	}
+	// NFC object holds one pending write, a broadcast is dropped and a write addressed
+	// to the NFC is answered busy until it is written.
+	if (MinSlave_nfcBusyPRIV() || !NFC_writeAllowed(registerNumber * MODBUS_BYTES_PER_REG, dataLength)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
+	}
+	// From here the write is always taken: flagged for the Scheduler or into the write back pages
+	NFC_countWrite(registerNumber * MODBUS_BYTES_PER_REG, dataLength);
 	
 	// Check if MASTER is broadcasting a block of its registers (slave address is 0 for master broadcast)
-		//if (pMinSlaveSelf->uart.rxBuffer[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST && pMinSlaveSelf->slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] == INITIALIZED) {
-		if (pMinSlaveSelf->uart.rxBuffer[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST)
+		//if (pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST && pMinSlaveSelf->slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] == INITIALIZED) {
+		if (pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST)
 		 {
 			oNFC.broadcast.length = dataLength;
 		
@@ -524,255 +983,145 @@ static void ModbusSlave_writeRegistersPRIV(void) {
 		
 		//oNFC.broadcast.registerNumber = (registerNumber);
 		
-		for (i = 0; i < (uint8_t) (dataLength); i++)   {
-			oNFC.broadcast.nfcBuffer[i] = *dataPtr++;
-			}
+		oNFC.broadcast.pNfcData = dataPtr;		// Frame is released after the NFC write
+		pMinSlaveSelf->pHandedOffFrame = pRxFrame;
 			oNFC.storeBroadcastFLG = TRUE;
 	
 	}
 	//write data to NFC memory instantly
-	//else if (pMinSlaveSelf->uart.rxBuffer[MODBUS_SLAVE_ADDRESS_INDEX] == NFC_SLAVE_ADDRESS && pMinSlaveSelf->slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] == INITIALIZED) {
-	else if (pMinSlaveSelf->uart.rxBuffer[MODBUS_SLAVE_ADDRESS_INDEX] == NFC_SLAVE_ADDRESS)
+	//else if (pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == NFC_SLAVE_ADDRESS && pMinSlaveSelf->slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] == INITIALIZED) {
+	else if (pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == NFC_SLAVE_ADDRESS)
 	 {		
-		oNFC.update.length = dataLength;
-		//if(blockNumber == BLOCK2 || blockNumber == BLOCK11 || blockNumber == BLOCK226)
-		//{//save Block instantly
-			//oNFC.update.blockNumber = blockNumber;
-			oNFC.update.registerNumber = registerNumber;
-			for (i = 0; i < (uint8_t) (dataLength); i++) {
-				oNFC.update.nfcBuffer[i] = *dataPtr++;
-			}
-			oNFC.instantWriteFLG = TRUE;
+		// Write back pages full or too few for the data, write it from the frame buffer
+		if (NFC_bufferWrite(registerNumber * MODBUS_BYTES_PER_REG, dataPtr, dataLength) != NO_WRITE_ERR) {
+			oNFC.update.length = dataLength;
+			//if(blockNumber == BLOCK2 || blockNumber == BLOCK11 || blockNumber == BLOCK226)
+			//{//save Block instantly
+				//oNFC.update.blockNumber = blockNumber;
+				oNFC.update.registerNumber = registerNumber;
+				oNFC.update.pNfcData = dataPtr;		// Frame is released after the NFC write
+				pMinSlaveSelf->pHandedOffFrame = pRxFrame;
+				oNFC.instantWriteFLG = TRUE;
+				// Master would time out before the write is done, it polls with FC03 instead
+				if (NFC_WRITE_MSEC(registerNumber * MODBUS_BYTES_PER_REG, dataLength) > MODBUS_RESPONSE_TIME_MSEC) {
+					MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ACKNOWLEDGE);
+					return;
+				}
+		}
 			// Reply is required for specific slave writing of registers. Reply is same as request for first 6 bytes received
-			dataPtr = &pMinSlaveSelf->uart.rxBuffer[MODBUS_SLAVE_ADDRESS_INDEX];
+			dataPtr = &pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX];
 
 			for (i = 0; i < MODBUS_FC_WRITE_REPLY_LENGTH; i++) {
 				txBuf[i] = *dataPtr++;
 			}
-			crc = get_crc_16 (0xFFFF, txBuf, MODBUS_FC_WRITE_REPLY_LENGTH);         // Calculate the CRC to send with reply slaveAddr, FC, addrH, addrL, dataH, datal
-			txBuf[MIN_FC_CRCL_INDEX] = (uint8_t) (crc & 0xff);             // CRCL
-			txBuf[MIN_FC_CRCH_INDEX] = (uint8_t) (crc >> 8);               // CRCH
-			txLength = MIN_FC_WRITE_REPLY_LENGTH + MIN_CRC_LENGTH;
-			// Enable the Tx line
-			minTxEnable();
+			txLength = MIN_FC_WRITE_REPLY_LENGTH;
 
 		// Send reply
 		MinSlave_sendReplyPRIV(txBuf, txLength);
 		}
 		
 	//}
-
-	FlagEEPBusy = EEPFree;
 }
 
 /*
  ========================================================================================
- Method name:  MinSlave_slavePollPRIV()
+ Method name:  MinSlave_writeSlaveRegisterPRIV()
 
- Originator:   Tom Van Sistine
+ Originator:   
 
  Description:
- 	 	 Respond to slave poll command with one of several responses based on priority
- 	 	 or scheduling.
- 	 	 00 No action needed (needed to limit responses if nothing to do)
- 	 	 01 Send register(s) to Master (i.e. setpoints, or data)
- 	 	 02 Broadcast registers (can start at a offset and vary in number)
- 	 	 03 OTA packet transfer to CCB (UIM with WiFi module or PC over the wire)
- 	 	 04 Send setpoint to other slave.
+ 	 	 Handles a write from the Master to one of the slave registers (register number
+		 MODBUS_SLAVE_REGISTER_BASE + reg). Only registers that configure the slave can
+		 be written, the others are read only and the write is answered with
+		 exception 02 by the caller. An NFC write policy register is saved in the
+		 NFC with NFC_savePolicy(), it keeps its old value if it can not be saved.
+
+		 Returned values
+		 MINSLAVE_PUT_SLAVE_DATA_SUCCESS = 0,
+		 MINSLAVE_PUT_SLAVE_DATA_FAIL_INVALID_REGISTER,
+		 MINSLAVE_PUT_SLAVE_DATA_FAIL_INVALID_VALUE,	unknown policy
+		 MINSLAVE_PUT_SLAVE_DATA_FAIL_BUSY,			write back pages full
 
  Resources:
 
  ========================================================================================
  History:
  *-------*-----------*---------------------------------------------------*---------------
- 1.00    08-08-2019  Original code                                       Tom Van Sistine
- 1.01    09-25-2020  Modified so that NFC will return nothing when it	Anish Venkataraman
-					 time to broadcast
+ 1.00    10-16-2026  Original code
+ 1.01    10-16-2026  NFC write policy registers
  ----------------------------------------------------------------------------------------
  */
-static void MinSlave_slavePollPRIV(void) {
-	uint8_t txLength;
-
-	if(pMinSlaveSelf->slavePollBroadcastInterval) {
-		pMinSlaveSelf->slavePollBroadcastInterval--;
-	}
-
-	// Setup reply first to bytes common to all responses
-	txBuf[MIN_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
-	txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC65_SLAVE_POLL;         // Function code
-
-	// Determine what type of response should be sent.
-	if (pMinSlaveSelf->changeDataFlag) {
-		// Setpoint(s) are queued up to send
-		txLength = MinSlave_spSendRegistersPRIV();
-	}
-
-	else if(pMinSlaveSelf->slavePollBroadcastInterval == 0) {
-		// Broadcast some slave registers
-		txLength = MinSlave_spNothingToRespondPRIV();
-	}
-
-	else {
-		// Send nothing to respond this time type
-		txLength = MinSlave_spNothingToRespondPRIV();
-	}
-
-	// Send response - common to all types.
-	// Enable the Tx line
-	minTxEnable();
-
-	// Send reply
-	MinSlave_sendReplyPRIV(txBuf, txLength);
-}
-
-/*
-static void ModbusSlave_slavePollPRIV(void) {
-	uint8_t txLength;
+static uint8_t MinSlave_writeSlaveRegisterPRIV(uint16_t reg, uint16_t data) {
+	uint16_t previous;
 
-	if(pMinSlaveSelf->slavePollBroadcastInterval) {
-		pMinSlaveSelf->slavePollBroadcastInterval--;
-	}
+	switch (reg) {
 
-	// Setup reply first to bytes common to all responses
-	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
-	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC65_SLAVE_POLL;         // Function code
+		case MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM:
+		pMinSlaveSelf->slaveRegisters[reg] = data;
+		break;
 
-	// Determine what type of response should be sent.
-	if (pMinSlaveSelf->changeDataFlag) {
-		// Setpoint(s) are queued up to send
-		txLength = MinSlave_spSendRegistersPRIV();
-	}
+		case MIN_SLAVE_TURNAROUND_USEC_RNUM:
+		pMinSlaveSelf->slaveRegisters[reg] = data;
+		MinUart_setTurnaround(&pMinSlaveSelf->uart, data);	// Applies from the next request
+		break;
 
-	else if(pMinSlaveSelf->slavePollBroadcastInterval == 0) {
-		// Broadcast some slave registers
-		txLength = MinSlave_spNothingToRespondPRIV();
-	}
+		case MIN_SLAVE_REGION0_POLICY_RNUM:
+		case MIN_SLAVE_REGION1_POLICY_RNUM:
+		case MIN_SLAVE_REGION2_POLICY_RNUM:
+		case MIN_SLAVE_REGION3_POLICY_RNUM:
+		case MIN_SLAVE_REGION4_POLICY_RNUM:
+		if ((data >> NFC_POLICY_SHIFT) >= NFC_POLICIES) {
+			return MINSLAVE_PUT_SLAVE_DATA_FAIL_INVALID_VALUE;
+		}
+		// falls through, saved like the interval
+		case MIN_SLAVE_POLICY_INTERVAL_RNUM:
+		previous = pMinSlaveSelf->slaveRegisters[reg];
+		pMinSlaveSelf->slaveRegisters[reg] = data;
+		if (NFC_savePolicy() != NO_WRITE_ERR) {
+			pMinSlaveSelf->slaveRegisters[reg] = previous;
+			return MINSLAVE_PUT_SLAVE_DATA_FAIL_BUSY;
+		}
+		break;
 
-	else {
-		// Send nothing to respond this time type
-		txLength = MinSlave_spNothingToRespondPRIV();
+		default:
+		return MINSLAVE_PUT_SLAVE_DATA_FAIL_INVALID_REGISTER;
 	}
-
-	// Send response - common to all types.
-	// Enable the Tx line
-	minTxEnable();
-
-	// Send reply
-	MinSlave_sendReplyPRIV(txBuf, txLength);
+	return MINSLAVE_PUT_SLAVE_DATA_SUCCESS;
 }
-*/
 
 /*
  ========================================================================================
- Method name:  MinSlave_writeRegistersPRIV()
+ Method name:  MinSlave_putExceptionPRIV()
 
- Originator:   Tom Van Sistine
+ Originator:   
 
  Description:
- 	 	 Handles write multiple registers (block writes) which can be Master broadcast
- 	 	 blocks (no reply) or multiple slave registers (with reply).
+ 	 	 Returns the exception code for a failed MinSlave_writeSlaveRegisterPRIV():
+		 02 for a register that can not be written, 03 for a value that is not
+		 allowed and 06 when it could not be saved.
 
  Resources:
 
  ========================================================================================
  History:
  *-------*-----------*---------------------------------------------------*---------------
- 1.00    08-07-2019  Original code broke out MinSlave_manageMessages()   Tom Van Sistine
- 1.01	 11-04-2019  Added code to store data in an array and once all Anish Venkataraman
-					 data is received set the flag to TRUE.	
- 1.02    06-04-2020  Modified the code to store the respective block   Anish Venkataraman
-					 register to NFC object					 
- 1.03    06-15-2020  Added instantaneous write for max of 8 bytes	   Anish Venkataraman
-					 Added code to support BLK 226 	
- 1.04    06-26-2020  Refactored code								   Anish Venkataraman
- 1.05    08-12-2020  Modified code to write instantaneous only when	   Anish Venkataraman					 
-					 addressed to NFC and refactored it.
- 1.06    08-28-2020  Added reply when addressed to NFC				   Anish Venkataraman
- 1.07    02-19-2021  Added check for permission to save data		   Anish Venkataraman
+ 1.00    10-16-2026  Original code
  ----------------------------------------------------------------------------------------
  */
+static uint8_t MinSlave_putExceptionPRIV(uint8_t result) {
 
-static void MinSlave_writeRegistersPRIV(void) {
-	uint8_t i;							// Generic index variable used where needed
-	uint8_t txLength;
-	uint16_t crc;
-	uint8_t * dataPtr;
-	uint8_t blockNumber;
-	uint8_t registerNumber;
-	uint8_t dataLength;
-	blockNumber = pMinSlaveSelf->uart.rxBuffer[MIN_FC16_BLOCK_INDEX]; //get block number
-	registerNumber = pMinSlaveSelf->uart.rxBuffer[MIN_FC16_REGISTER_INDEX]; //get the register number
-	dataLength = pMinSlaveSelf->uart.rxBuffer[MIN_FC16_BYTES_TO_RX_INDEX]; //length of the data to be written
-	// Initialize source data pointer to start of register data in rxBuffer
-	dataPtr = &pMinSlaveSelf->uart.rxBuffer[MIN_FC16_DATA_START_INDEX];	// Set pointer to first incoming register value high byte.
-	// Check if MASTER is broadcasting a block of its registers (slave address is 0 for master broadcast)
-	if (pMinSlaveSelf->uart.rxBuffer[MIN_SLAVE_ADDRESS_INDEX] == MIN_MASTER_BROADCAST && pMinSlaveSelf->slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] == INITIALIZED) {
-		oNFC.broadcast.length = dataLength;
-		
-		if(blockNumber == BLOCK2 && oNFC.block2WriteFLG == TRUE){ //store block 2
-			oNFC.broadcast.blockNumber = blockNumber;//store block number
-			oNFC.broadcast.registerNumber = registerNumber;//store register to be written
-			for (i = 0; i < (uint8_t) (dataLength); i++) {
-				oNFC.broadcast.nfcBuffer[i] = *dataPtr++;//store data
-			}
-			oNFC.storeBroadcastFLG = TRUE;
-			
-		}
-		else if(blockNumber == BLOCK11 && oNFC.block11WriteFLG == TRUE){//store block 11
-			oNFC.broadcast.blockNumber = blockNumber;
-			oNFC.broadcast.registerNumber = registerNumber;
-			for (i = 0; i < (uint8_t) (dataLength); i++) {
-				oNFC.broadcast.nfcBuffer[i] = *dataPtr++;
-			}
-			oNFC.storeBroadcastFLG = TRUE;
-		}
-		else if(blockNumber == BLOCK226 && oNFC.block226WriteFLG == TRUE){//store block 226
-		oNFC.broadcast.blockNumber = blockNumber;
-		oNFC.broadcast.registerNumber = registerNumber;
-		for (i = 0; i < (uint8_t) (dataLength); i++) {
-				oNFC.broadcast.nfcBuffer[i] = *dataPtr++;
-			}
-			oNFC.storeBroadcastFLG = TRUE;
-		}
-		else{
-			//do nothing
-		}		
-		// Note: there is no reply for master broadcast of a its block.
+	if (result == MINSLAVE_PUT_SLAVE_DATA_FAIL_INVALID_VALUE) {
+		return MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
 	}
-	//write data to NFC memory instantly
-	else if (pMinSlaveSelf->uart.rxBuffer[MIN_SLAVE_ADDRESS_INDEX] == NFC_SLAVE_ADDRESS && pMinSlaveSelf->slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] == INITIALIZED) {
-		oNFC.update.length = dataLength;
-		if(blockNumber == BLOCK2 || blockNumber == BLOCK11 || blockNumber == BLOCK226){//save Block instantly
-			oNFC.update.blockNumber = blockNumber;
-			oNFC.update.registerNumber = registerNumber;
-			for (i = 0; i < (uint8_t) (dataLength); i++) {
-				oNFC.update.nfcBuffer[i] = *dataPtr++;
-			}
-			oNFC.instantWriteFLG = TRUE;
-			// Reply is required for specific slave writing of registers. Reply is same as request for first 6 bytes received
-			dataPtr = &pMinSlaveSelf->uart.rxBuffer[MIN_SLAVE_ADDRESS_INDEX];
-
-			for (i = 0; i < MIN_FC_WRITE_REPLY_LENGTH; i++) {
-				txBuf[i] = *dataPtr++;
-			}
-			crc = get_crc_16 (0xFFFF, txBuf, MIN_FC_WRITE_REPLY_LENGTH);         // Calculate the CRC to send with reply slaveAddr, FC, addrH, addrL, dataH, datal
-			txBuf[MIN_FC_CRCL_INDEX] = (uint8_t) (crc & 0xff);             // CRCL
-			txBuf[MIN_FC_CRCH_INDEX] = (uint8_t) (crc >> 8);               // CRCH
-			txLength = MIN_FC_WRITE_REPLY_LENGTH + MIN_CRC_LENGTH;
-			// Enable the Tx line
-			minTxEnable();
-
-		// Send reply
-		MinSlave_sendReplyPRIV(txBuf, txLength);
-		}
-		
+	if (result == MINSLAVE_PUT_SLAVE_DATA_FAIL_BUSY) {
+		return MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY;
 	}
-
+	return MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
 }
 
 /*
  ========================================================================================
- Method name:  ModbusSlave_slavePollPRIV()
+ Method name:  MinSlave_slavePollPRIV()
 
  Originator:   Tom Van Sistine
 
@@ -795,7 +1144,7 @@ static void MinSlave_writeRegistersPRIV(void) {
 					 time to broadcast
  ----------------------------------------------------------------------------------------
  */
-static void ModbusSlave_slavePollPRIV(void) {
+static void MinSlave_slavePollPRIV(void) {
 	uint8_t txLength;
 
 	if(pMinSlaveSelf->slavePollBroadcastInterval) {
@@ -803,8 +1152,8 @@ static void ModbusSlave_slavePollPRIV(void) {
 	}
 
 	// Setup reply first to bytes common to all responses
-	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
-	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC65_SLAVE_POLL;         // Function code
+	txBuf[MIN_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC65_SLAVE_POLL;         // Function code
 
 	// Determine what type of response should be sent.
 	if (pMinSlaveSelf->changeDataFlag) {
@@ -823,8 +1172,6 @@ static void ModbusSlave_slavePollPRIV(void) {
 	}
 
 	// Send response - common to all types.
-	// Enable the Tx line
-	minTxEnable();
 
 	// Send reply
 	MinSlave_sendReplyPRIV(txBuf, txLength);
@@ -850,7 +1197,6 @@ static void ModbusSlave_slavePollPRIV(void) {
  */
 static uint8_t MinSlave_spSendRegistersPRIV(void) {
 	uint8_t i;
-	uint16_t crc;
 	uint8_t * dataPtr;
 	pMinSlaveSelf->changeDataFlag = FALSE;
 	dataPtr = &txBuf[MIN_FC65_TYPE_CODE_INDEX];
@@ -863,9 +1209,6 @@ static uint8_t MinSlave_spSendRegistersPRIV(void) {
 		*dataPtr++ = (uint8_t) (*pMinSlaveSelf->pDataToChange++ & 0xff);	// Low byte of register
 	}
 
-	crc = get_crc_16 (0xFFFF, txBuf, MIN_FC65_SETPOINT_RESPONSE_PREFIX_LENGTH + (i * 2));         // Calculate the CRC to send with reply
-	*dataPtr++ = (uint8_t) (crc & 0xff);   // CRCL
-	*dataPtr++ = (uint8_t) (crc >> 8); // CRCH
 	return ((uint8_t) (dataPtr - txBuf));
 
 }
@@ -888,18 +1231,11 @@ static uint8_t MinSlave_spSendRegistersPRIV(void) {
 ----------------------------------------------------------------------------------------
  */
 static uint8_t MinSlave_spNothingToRespondPRIV(void) {
-	uint16_t crc;
 	uint8_t txLength;
-	uint8_t * dataPtr;
 
 	txBuf[MIN_FC65_TYPE_CODE_INDEX] = MIN_FC65_NO_RESPONSE_CODE;
 
-	// Set destination pointer to txBuf
-	dataPtr = &txBuf[MIN_FC65_TYPE_CODE_INDEX + 1];
-	crc = get_crc_16 (0xFFFF, txBuf, (MIN_FC65_NO_RESPONSE_LENGTH - MIN_CRC_LENGTH));         // Calculate the CRC to send with reply
-	*dataPtr++ = (uint8_t) (crc & 0xff);   // CRCL
-	*dataPtr = (uint8_t) (crc >> 8); // CRCH
-	txLength = MIN_FC65_NO_RESPONSE_LENGTH;
+	txLength = MIN_FC65_NO_RESPONSE_LENGTH - MIN_CRC_LENGTH;
 	return txLength;
 }
 
@@ -910,6 +1246,13 @@ static uint8_t MinSlave_spNothingToRespondPRIV(void) {
  Originator:	Tom Van Sistine
 
  Description: 	Transmits reply back to Master.
+				txLength does not include the CRC, the CRC is calculated as the
+				characters are queued and appended here.
+				The reply is queued in the UART transmit buffer and sent from the
+				Data Register Empty interrupt, so this only waits if the reply is
+				longer than the transmit buffer. Uses MinSlave_replyStartPRIV(),
+				MinSlave_replyBytePRIV() and MinSlave_replyEndPRIV(), which handlers
+				call directly to stream a reply as its data is read.
 
 
  Resources:		HardwareUart_SendChar() needs to be defined in IoTranslate.h
@@ -918,21 +1261,168 @@ static uint8_t MinSlave_spNothingToRespondPRIV(void) {
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    07-11-2019  Original code                                       Tom Van Sistine
+ 1.01    10-16-2026  Reply sent from transmit ring buffer
+ 1.02    10-16-2026  CRC calculated per character and appended
+ 1.03    10-16-2026  Queued with MinSlave_replyBytePRIV()
 
  ----------------------------------------------------------------------------------------
  */
 void MinSlave_sendReplyPRIV(uint8_t * pSrc, uint8_t txLength) {
 	uint8_t i;
-	unsigned char data;
 	assert(txLength);
 	assert(pSrc);
+	MinSlave_replyStartPRIV();
 	for (i = 0; i < txLength; i++) {
-		data = (unsigned char)*pSrc++;
-		(void) HardwareUart_SendChar(data);
+		MinSlave_replyBytePRIV(*pSrc++);
+	}
+	MinSlave_replyEndPRIV();
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_replyStartPRIV()
+
+ Originator:
+
+ Description: 	Starts a reply queued a character at a time with
+				MinSlave_replyBytePRIV() and finished with MinSlave_replyEndPRIV().
+				The reply is armed after MIN_SLAVE_REPLY_LEAD characters, a handler
+				streaming from the NFC sets replyLead after this.
+
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ 1.01    10-16-2026  Lead set to MIN_SLAVE_REPLY_LEAD
+ ----------------------------------------------------------------------------------------
+ */
+static void MinSlave_replyStartPRIV(void) {
+	replyCrc = 0xFFFF;
+	replyQueued = 0;
+	replyLead = MIN_SLAVE_REPLY_LEAD;
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_replyBytePRIV()
+
+ Originator:
+
+ Description: 	Queues one character of the reply and adds it to the CRC. The reply
+				is armed once replyLead characters are queued, so it goes out while
+				the rest is still being read and the transmit buffer keeps ahead of
+				the line without a gap in the frame.
+
+ Resources:		HardwareUart_SendChar() needs to be defined in IoTranslate.h
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ 1.01    10-16-2026  Armed after replyLead characters
+ ----------------------------------------------------------------------------------------
+ */
+static void MinSlave_replyBytePRIV(uint8_t data) {
+	unsigned char txChar = (unsigned char)data;
+
+	replyCrc = update_crc_16(replyCrc, txChar);
+	(void) HardwareUart_SendChar(txChar);
+	replyQueued++;
+	if (replyQueued == replyLead) {
+		Enable_TXInterrupt();
 	}
-	if(i == txLength){
-		Enable_TXInterrupt(); 
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_replyNfcBytePRIV()
+
+ Originator:
+
+ Description: 	Called by NFC_StreamRead() for each byte read from replyNfcAddress
+				on, queues the byte with MinSlave_replyBytePRIV() after taking the
+				data of an NFC write not done yet, see NFC_pendingByte().
+
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void MinSlave_replyNfcBytePRIV(uint8_t data) {
+	MinSlave_replyBytePRIV(NFC_pendingByte(&oNFC, replyNfcAddress, data));
+	replyNfcAddress++;
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_streamLeadPRIV()
+
+ Originator:
+
+ Description: 	Returns the characters of an FC03 reply to queue before it is armed
+				when length bytes are streamed from NFC address. Every cache line
+				still to be read is taken as a miss, MIN_SLAVE_LINE_FILL_USEC each.
+				The reply is armed once the rest of the read takes no longer than
+				sending the characters already queued at the selected baud rate, so
+				the line never waits for the I2C read and no gap splits the frame.
+				At least MIN_SLAVE_REPLY_LEAD. A lead past the end of the data arms
+				the reply with MinSlave_replyEndPRIV() once it is all read.
+
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_streamLeadPRIV(uint16_t address, uint8_t length) {
+	uint8_t lead = MIN_SLAVE_REPLY_LEAD;
+	uint8_t read;
+	uint16_t lines;
+	uint16_t charUsec;
+
+	charUsec = (uint16_t)(pMinSlaveSelf->uart.charTicks / TURNAROUND_TICKS_PER_USEC);
+	for (read = lead - MODBUS_FC03_DATA_START; read < length; read++, lead++) {
+		// cache lines from the one holding the next byte to the one holding the last
+		lines = (((address + length - 1U) / NFC_CACHE_LINE_SIZE) - ((address + read) / NFC_CACHE_LINE_SIZE)) + 1U;
+		if (((uint32_t)lines * MIN_SLAVE_LINE_FILL_USEC) <= ((uint32_t)lead * charUsec)) {
+			break;
+		}
 	}
+	return lead;
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_replyEndPRIV()
+
+ Originator:
+
+ Description: 	Appends the CRC to the reply and arms it if it was shorter than
+				replyLead.
+
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void MinSlave_replyEndPRIV(void) {
+	unsigned char data;
+
+	data = (unsigned char) (replyCrc & 0xff);	// CRCL
+	(void) HardwareUart_SendChar(data);
+	data = (unsigned char) (replyCrc >> 8);		// CRCH
+	(void) HardwareUart_SendChar(data);
+	Enable_TXInterrupt();
 }
 
 
@@ -1055,7 +1545,7 @@ uint8_t MinSlave_putSlaveData(uint8_t reg, uint16_t data) {   // Putter function
 
 /*
  ========================================================================================
- Method name:  MinSlave_replyRegisterRequestPRIV()
+ Method name:  ModbusSlave_replyRegisterRequestPRIV()
 
  Originator:   Tom Van Sistine
 
@@ -1073,146 +1563,821 @@ uint8_t MinSlave_putSlaveData(uint8_t reg, uint16_t data) {   // Putter function
  1.02	 04-15-2020  Added code to read Block 2 and 11				   Anish Venkataraman
  1.03	 06-15-2020  Added code to read Block 226					   Anish Venkataraman
  1.04	 06-26-2020  Modified the code to support sequential read	   Anish Venkataraman
+ 1.05	 08-11-2022	 Modified the code to support Modbus read		   Onkar Raut
+ 1.06	 10-16-2026	 Read slave registers at MODBUS_SLAVE_REGISTER_BASE
+ 1.07	 10-16-2026	 Read straight into txBuf, up to 125 registers
+ 1.08	 10-16-2026	 Exception 06 when NFC is busy
+ 1.09	 10-16-2026	 Exception 03 for bad quantity, 02 outside slave registers
+					 or NFC memory
+ 1.10	 10-16-2026	 Registers read with MinSlave_readRegistersPRIV()
+ 1.11	 10-16-2026	 NFC data streamed from the I2C read to the UART
+ 1.12	 10-16-2026	 Pending NFC writes included, not busy while only pending
+ 1.13	 10-16-2026	 Streamed reply armed after MinSlave_streamLeadPRIV()
+ 1.14	 10-16-2026	 Removed unused variables and commented out code
  ----------------------------------------------------------------------------------------
  */
-static void MinSlave_replyRegisterRequestPRIV(void) {
-
-	uint8_t i = 0;;							// Generic index variable used where needed
+static void ModbusSlave_replyRegisterRequestPRIV(void) {
+	
+	uint8_t i = 0;							// Generic index variable used where needed
 	uint8_t * dataPtr;
-	uint16_t crc;
 	uint8_t txLength;
-	uint8_t blockNumber = 0;
-	uint8_t registerNumber;				//Requested Register
-	uint16_t address;
+	uint16_t registerNumber;				//Requested Register
 	uint8_t length;
-	uint8_t read[NFC_MAX_MEM];	//array to store read data
+	uint8_t exceptionCode;
+	
+	// 125 registers is the most that fits in a Modbus reply frame
+	if ((pRxFrame[MODBUS_FC03_NUM_REG_INDEX - 1] != 0) || (pRxFrame[MODBUS_FC03_NUM_REG_INDEX] == 0) ||
+		(pRxFrame[MODBUS_FC03_NUM_REG_INDEX] > MODBUS_FC03_MAX_REGISTERS)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+		return;
+	}
+	
 	// Setup reply
-	txBuf[MIN_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
-	//txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC03;                    			// Function code
-	txBuf[MIN_FC03_BYTES_REPLY_INDEX] = pMinSlaveSelf->uart.rxBuffer[MIN_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG;
-	length = pMinSlaveSelf->uart.rxBuffer[MIN_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG; 
-	// Get requested registers
-	blockNumber = pMinSlaveSelf->uart.rxBuffer[MIN_FC16_BLOCK_INDEX];
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC03;                    			// Function code
+	txBuf[MODBUS_FC03_BYTES_REPLY_INDEX] = pRxFrame[MODBUS_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG;
+	length = pRxFrame[MODBUS_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG; 
 	//Set pointer to the Tx Buffer
-	dataPtr = &txBuf[MIN_FC03_DATA_START];
+	dataPtr = &txBuf[MODBUS_FC03_DATA_START];
 	//Store Register Number
-	registerNumber = (uint8_t) ((pMinSlaveSelf->uart.rxBuffer[MIN_FC03_START_ADDR_INDEX] * 2));
 
-	////Reply with Block 2 Data
-	//if (blockNumber == BLOCK2) {
-		//address = (uint16_t)(BLOCK2_OFFSET + registerNumber);
-	//}
-	////reply with Block 11 Data
-	//else if(blockNumber == BLOCK11){
-		//address = (uint16_t)(BLOCK11_OFFSET + registerNumber);	
-	//}
-	//else{
-		//address = (uint16_t)(BLOCK226_OFFSET + registerNumber);
-	//}
-	
-	address = (uint16_t)(HOLDING_REG_OFFSET + registerNumber);
+	registerNumber = (uint16_t)(pRxFrame[MODBUS_FC03_MSB_ADDR_INDEX]);
+	registerNumber = registerNumber << 8;
+	registerNumber = registerNumber | (uint16_t)(pRxFrame[MODBUS_FC03_START_ADDR_INDEX]);
 	
-	NFC_SequentialRead(address,length,read);
-	//Copy to txBuf
-	for (i = 0; i < length; i++) {
-		*dataPtr++ = read[i];
-	}
-	crc = get_crc_16 (0xFFFF, txBuf, MIN_FC03_START_ADDR_INDEX + length);// Calculate the CRC to send with reply
-	*dataPtr++ = (uint8_t) (crc & 0xff);   // CRCL
-	*dataPtr = (uint8_t) (crc >> 8); // CRCH
-	txLength = (MIN_FC03_DATA_START + length + MIN_CRC_LENGTH);
-	// Enable the Tx line
-	minTxEnable();
-	// Send reply
-	MinSlave_sendReplyPRIV(txBuf, txLength);
-
+	exceptionCode = MinSlave_checkRegistersPRIV(registerNumber, pRxFrame[MODBUS_FC03_NUM_REG_INDEX], NFC_REGION_READ);
+	if (exceptionCode != 0) {
+		MinSlave_sendExceptionPRIV(exceptionCode);
+		return;
+	}
+	if (registerNumber >= MODBUS_SLAVE_REGISTER_BASE) {
+		MinSlave_readRegistersPRIV(registerNumber, pRxFrame[MODBUS_FC03_NUM_REG_INDEX], dataPtr);	//Read straight into txBuf
+		txLength = (MODBUS_FC03_DATA_START + length);
+		// Send reply
+		MinSlave_sendReplyPRIV(txBuf, txLength);
+		return;
+	}
+	// NFC memory, header queued now and each byte queued as it comes off the I2C bus
+	MinSlave_replyStartPRIV();
+	for (i = 0; i < MODBUS_FC03_DATA_START; i++) {
+		MinSlave_replyBytePRIV(txBuf[i]);
+	}
+	FlagEEPBusy = EEPBusy;
+	replyNfcAddress = registerNumber * MODBUS_BYTES_PER_REG;
+	replyLead = MinSlave_streamLeadPRIV(replyNfcAddress, length);
+	NFC_StreamRead(replyNfcAddress, length, MinSlave_replyNfcBytePRIV);
+	FlagEEPBusy = EEPFree;
+	MinSlave_replyEndPRIV();
 }
 
 /*
  ========================================================================================
- Method name:  ModbusSlave_replyRegisterRequestPRIV()
+ Method name:  ModbusSlave_replyInputRegistersPRIV()
 
- Originator:   Tom Van Sistine
+ Originator:   
 
  Description:
 
- 	 	 Replies with the data from slave register requested by master
+ 	 	 Handles FC04, replies with input registers. Input registers are read only
+		 live state: slave register n at register number n, slave counter n at
+		 MODBUS_INPUT_COUNTER_BASE + n and bus counter n at
+		 MODBUS_INPUT_UART_COUNTER_BASE + n. The NFC is not used. Exception 06
+		 for an NFC region digest not computed yet, see MinSlave_digestBusyPRIV().
  Resources:
 
  ========================================================================================
  History:
  *-------*-----------*---------------------------------------------------*---------------
- 1.00    08-07-2019  Original code broke out MinSlave_manageMessages()   Tom Van Sistine
- 1.01	 11-04-2019  Added code to read from NFC and append it to the  Anish Venkataraman
-					 MIN_SLAVE_MODEL_CONFIGURATION_CODE.
- 1.02	 04-15-2020  Added code to read Block 2 and 11				   Anish Venkataraman
- 1.03	 06-15-2020  Added code to read Block 226					   Anish Venkataraman
- 1.04	 06-26-2020  Modified the code to support sequential read	   Anish Venkataraman
- 1.05	 08-11-2022	 Modified the code to support Modbus read		   Onkar Raut
+ 1.00    10-16-2026  Original code
+ 1.01    10-16-2026  Bus counters
+ 1.02    10-16-2026  Exception 06 for an NFC region digest not computed yet
  ----------------------------------------------------------------------------------------
  */
-static void ModbusSlave_replyRegisterRequestPRIV(void) {
-	
-	unsigned char temp;
-
-	uint8_t i = 0;;							// Generic index variable used where needed
+static void ModbusSlave_replyInputRegistersPRIV(void) {
+	uint8_t i;
 	uint8_t * dataPtr;
-	uint16_t crc;
-	uint8_t txLength;
-	uint8_t blockNumber = 0;
-	uint16_t registerNumber;				//Requested Register
-	uint16_t address;
-	uint8_t length;
-	uint8_t read[NFC_MAX_MEM];	//array to store read data
-	
-	
-	FlagEEPBusy = EEPBusy;
-	
-	// Setup reply
+	uint16_t registerNumber;
+	uint16_t quantity;
+	uint16_t * pSource;
+	uint16_t numberOfRegisters;
+	uint16_t uartCounters[MIN_UART_NUMBER_OF_COUNTERS];
+
+	registerNumber = MODBUS_WORD(pRxFrame, MODBUS_FC03_START_ADDR_INDEX);
+	quantity = MODBUS_WORD(pRxFrame, MODBUS_FC03_NUM_REG_INDEX);
+	if ((quantity == 0) || (quantity > MODBUS_FC03_MAX_REGISTERS)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+		return;
+	}
+	if (registerNumber >= MODBUS_INPUT_UART_COUNTER_BASE) {
+		registerNumber = registerNumber - MODBUS_INPUT_UART_COUNTER_BASE;
+		MinUart_copyCounters(&pMinSlaveSelf->uart, uartCounters);
+		pSource = uartCounters;
+		numberOfRegisters = MIN_UART_NUMBER_OF_COUNTERS;
+	}
+	else if (registerNumber >= MODBUS_INPUT_COUNTER_BASE) {
+		registerNumber = registerNumber - MODBUS_INPUT_COUNTER_BASE;
+		pSource = pMinSlaveSelf->counters;
+		numberOfRegisters = MIN_SLAVE_NUMBER_OF_COUNTERS;
+	}
+	else {
+		pSource = pMinSlaveSelf->slaveRegisters;
+		numberOfRegisters = MIN_SLAVE_NUMBER_OF_REGISTERS;
+	}
+	if ((registerNumber + quantity) > numberOfRegisters) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
+	}
+	if ((pSource == pMinSlaveSelf->slaveRegisters) && MinSlave_digestBusyPRIV(registerNumber, quantity)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
+	}
+	pSource = &pSource[registerNumber];
+
 	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
-	txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC03;                    			// Function code
-	txBuf[MODBUS_FC03_BYTES_REPLY_INDEX] = pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG;
-	length = pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_NUM_REG_INDEX] * MIN_BYTES_PER_REG; 
-	// Get requested registers
-	blockNumber = pMinSlaveSelf->uart.rxBuffer[MODBUS_FC16_BLOCK_INDEX];
-	//Set pointer to the Tx Buffer
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC04;                    		// Function code
+	txBuf[MODBUS_FC03_BYTES_REPLY_INDEX] = (uint8_t)(quantity * MODBUS_BYTES_PER_REG);
 	dataPtr = &txBuf[MODBUS_FC03_DATA_START];
-	//Store Register Number
+	for (i = 0; i < quantity; i++) {
+		*dataPtr++ = (uint8_t)(*pSource >> 8);			// Data High
+		*dataPtr++ = (uint8_t)(*pSource++ & 0xFF);		// Data Low
+	}
+	MinSlave_sendReplyPRIV(txBuf, (uint8_t)(MODBUS_FC03_DATA_START + (quantity * MODBUS_BYTES_PER_REG)));
+}
 
-	registerNumber = (uint16_t)(pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_MSB_ADDR_INDEX]);
-	registerNumber = registerNumber << 8;
-	registerNumber = registerNumber | (uint16_t)(pMinSlaveSelf->uart.rxBuffer[MODBUS_FC03_START_ADDR_INDEX]);
-//	registerNumber = ((uint16_t)registerNumber - 0x9C40);
-	
-	registerNumber = (uint16_t)registerNumber * 2;
-	
+/*
+ ========================================================================================
+ Method name:  ModbusSlave_readWriteRegistersPRIV()
 
-	address = (uint16_t)registerNumber;
-	
-	NFC_SequentialRead(address,length,read);
-	//Copy to txBuf
-	for (i = 0; i < length; i++) {
-		*dataPtr++ = read[i];
-	}
-	crc = get_crc_16 (0xFFFF, txBuf, MODBUS_FC03_START_ADDR_INDEX + length);// Calculate the CRC to send with reply
-	*dataPtr++ = (uint8_t) (crc & 0xff);   // CRCL
-	*dataPtr = (uint8_t) (crc >> 8); // CRCH
-	txLength = (MODBUS_FC03_DATA_START + length + MODBUS_CRC_LENGTH);
-	// Enable the Tx line
-	minTxEnable();
-	// Send reply
-	MinSlave_sendReplyPRIV(txBuf, txLength);
-	
+ Originator:   
+
+ Description:
+
+ 	 	 Handles FC23, writes registers to NFC memory and then replies with the
+		 registers read, so the master can check what was stored with one request.
+		 The write is taken into the write back pages with NFC_bufferWrite() and the
+		 registers read include it, see MinSlave_readRegistersPRIV(). When the pages
+		 are full it is written before the reply only if that fits in the response
+		 time, else exception 06. Only NFC memory is written, registers read can also
+		 be slave registers. Exception 06 when the NFC write policy refuses the write.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ 1.01    10-16-2026  Write checked with NFC_takeWrite()
+ 1.02    10-16-2026  Write taken with NFC_bufferWrite(), written directly only
+					 when the write back pages are full
+ 1.03    10-16-2026  Write counted for its policy only once taken
+ 1.04    10-16-2026  NFC write time counts the pages from the start address
+ ----------------------------------------------------------------------------------------
+ */
+static void ModbusSlave_readWriteRegistersPRIV(void) {
+	uint16_t readRegister;
+	uint16_t readQuantity;
+	uint16_t writeRegister;
+	uint16_t writeQuantity;
+	uint8_t exceptionCode;
+
+	readRegister = MODBUS_WORD(pRxFrame, MODBUS_FC23_READ_START_INDEX);
+	readQuantity = MODBUS_WORD(pRxFrame, MODBUS_FC23_READ_NUM_REG_INDEX);
+	writeRegister = MODBUS_WORD(pRxFrame, MODBUS_FC23_WRITE_START_INDEX);
+	writeQuantity = MODBUS_WORD(pRxFrame, MODBUS_FC23_WRITE_NUM_REG_INDEX);
+	if ((readQuantity == 0) || (readQuantity > MODBUS_FC03_MAX_REGISTERS) ||
+		(writeQuantity == 0) || (writeQuantity > MODBUS_FC23_MAX_WRITE_REGISTERS) ||
+		(pRxFrame[MODBUS_FC23_BYTES_TO_RX_INDEX] != (writeQuantity * MODBUS_BYTES_PER_REG))) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+		return;
+	}
+	if (writeRegister >= MODBUS_SLAVE_REGISTER_BASE) {	//only NFC memory is written
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
+	}
+	exceptionCode = MinSlave_checkRegistersPRIV(writeRegister, (uint8_t)writeQuantity, NFC_REGION_WRITE);
+	if (exceptionCode == 0) {
+		exceptionCode = MinSlave_checkRegistersPRIV(readRegister, (uint8_t)readQuantity, NFC_REGION_READ);
+	}
+	if (exceptionCode != 0) {
+		MinSlave_sendExceptionPRIV(exceptionCode);
+		return;
+	}
+	if (!NFC_writeAllowed(writeRegister * MODBUS_BYTES_PER_REG, pRxFrame[MODBUS_FC23_BYTES_TO_RX_INDEX])) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
+	}
+	if (NFC_bufferWrite(writeRegister * MODBUS_BYTES_PER_REG, &pRxFrame[MODBUS_FC23_DATA_START_INDEX],
+						pRxFrame[MODBUS_FC23_BYTES_TO_RX_INDEX]) != NO_WRITE_ERR) {
+		// Write back pages full, write it now only if the master does not time out
+		if (NFC_WRITE_MSEC(writeRegister * MODBUS_BYTES_PER_REG, pRxFrame[MODBUS_FC23_BYTES_TO_RX_INDEX]) > MODBUS_RESPONSE_TIME_MSEC) {
+			MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+			return;
+		}
+		FlagEEPBusy = EEPBusy;
+		NFC_compareWrite(&oNFC, writeRegister * MODBUS_BYTES_PER_REG, &pRxFrame[MODBUS_FC23_DATA_START_INDEX],
+						 pRxFrame[MODBUS_FC23_BYTES_TO_RX_INDEX], 0);
+		FlagEEPBusy = EEPFree;
+	}
+	NFC_countWrite(writeRegister * MODBUS_BYTES_PER_REG, pRxFrame[MODBUS_FC23_BYTES_TO_RX_INDEX]);
+
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC23;                    		// Function code
+	txBuf[MODBUS_FC03_BYTES_REPLY_INDEX] = (uint8_t)(readQuantity * MODBUS_BYTES_PER_REG);
+	MinSlave_readRegistersPRIV(readRegister, (uint8_t)readQuantity, &txBuf[MODBUS_FC03_DATA_START]);
+	MinSlave_sendReplyPRIV(txBuf, (uint8_t)(MODBUS_FC03_DATA_START + (readQuantity * MODBUS_BYTES_PER_REG)));
+}
+
+/*
+ ========================================================================================
+ Method name:  ModbusSlave_diagnosticsPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Handles FC08 Diagnostics. Sub-function 00 echoes the request. Sub-functions
+		 0B to 12 reply with a bus (MinUart) or slave counter, 0A clears all counters
+		 and the comm event counter. Data must be 0000 for all but 00. Counters are
+		 also cleared on power up. This slave never sends exception 07, its NAK
+		 count is always 0.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void ModbusSlave_diagnosticsPRIV(void) {
+	uint8_t i;
+	uint16_t subFunction;
+	uint16_t data;
+	uint16_t uartCounters[MIN_UART_NUMBER_OF_COUNTERS];
+
+	subFunction = MODBUS_WORD(pRxFrame, MODBUS_FC08_SUB_FUNCTION_INDEX);
+	data = MODBUS_WORD(pRxFrame, MODBUS_FC08_DATA_INDEX);
+	if ((subFunction > MODBUS_DIAG_BUS_OVERRUN_COUNT) ||
+		((subFunction != MODBUS_DIAG_RETURN_QUERY_DATA) && (subFunction < MODBUS_DIAG_CLEAR_COUNTERS))) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_FUNCTION);
+		return;
+	}
+	if ((subFunction != MODBUS_DIAG_RETURN_QUERY_DATA) && (data != 0)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+		return;
+	}
+
+	MinUart_copyCounters(&pMinSlaveSelf->uart, uartCounters);
+	switch (subFunction) {
+		case MODBUS_DIAG_CLEAR_COUNTERS:
+			for (i = 0; i < MIN_SLAVE_NUMBER_OF_COUNTERS; i++) {
+				pMinSlaveSelf->counters[i] = 0;
+			}
+			MinUart_clearCounters(&pMinSlaveSelf->uart);
+			pMinSlaveSelf->eventCount = 0;
+			lastOverruns = 0;
+			lastCommErrors = 0;
+			break;
+		case MODBUS_DIAG_BUS_MESSAGE_COUNT:
+			data = uartCounters[MIN_UART_BUS_MESSAGE_CNUM];
+			break;
+		case MODBUS_DIAG_BUS_COMM_ERROR_COUNT:
+			data = uartCounters[MIN_UART_CRC_ERROR_CNUM] + uartCounters[MIN_UART_FRAMING_ERROR_CNUM];
+			break;
+		case MODBUS_DIAG_BUS_EXCEPTION_COUNT:
+			data = pMinSlaveSelf->counters[MIN_SLAVE_EXCEPTION_CNUM];
+			break;
+		case MODBUS_DIAG_SLAVE_MESSAGE_COUNT:
+			data = pMinSlaveSelf->counters[MIN_SLAVE_MESSAGE_CNUM];
+			break;
+		case MODBUS_DIAG_SLAVE_NO_RESPONSE_COUNT:
+			data = pMinSlaveSelf->counters[MIN_SLAVE_NO_RESPONSE_CNUM];
+			break;
+		case MODBUS_DIAG_SLAVE_BUSY_COUNT:
+			data = pMinSlaveSelf->counters[MIN_SLAVE_BUSY_CNUM];
+			break;
+		case MODBUS_DIAG_BUS_OVERRUN_COUNT:
+			data = uartCounters[MIN_UART_OVERRUN_CNUM];
+			break;
+		default:
+			break;		// Return query data and NAK count, data as received
+	}
+
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC08;                    		// Function code
+	txBuf[MODBUS_FC08_SUB_FUNCTION_INDEX - 1] = (uint8_t)(subFunction >> 8);
+	txBuf[MODBUS_FC08_SUB_FUNCTION_INDEX] = (uint8_t)(subFunction & 0xFF);
+	txBuf[MODBUS_FC08_DATA_INDEX - 1] = (uint8_t)(data >> 8);
+	txBuf[MODBUS_FC08_DATA_INDEX] = (uint8_t)(data & 0xFF);
+	MinSlave_sendReplyPRIV(txBuf, MODBUS_FC08_REPLY_LENGTH);
+}
+
+/*
+ ========================================================================================
+ Method name:  ModbusSlave_commEventCounterPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Handles FC11 Get Comm Event Counter. Status is FFFF while an NFC write of
+		 an earlier request is pending, the event count is the number of requests
+		 completed without exception.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void ModbusSlave_commEventCounterPRIV(void) {
+	uint16_t status;
+
+	status = MinSlave_nfcBusyPRIV() ? MODBUS_COMM_STATUS_BUSY : MODBUS_COMM_STATUS_READY;
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC11;                    		// Function code
+	txBuf[MODBUS_FC11_STATUS_INDEX - 1] = (uint8_t)(status >> 8);
+	txBuf[MODBUS_FC11_STATUS_INDEX] = (uint8_t)(status & 0xFF);
+	txBuf[MODBUS_FC11_EVENT_COUNT_INDEX - 1] = (uint8_t)(pMinSlaveSelf->eventCount >> 8);
+	txBuf[MODBUS_FC11_EVENT_COUNT_INDEX] = (uint8_t)(pMinSlaveSelf->eventCount & 0xFF);
+	MinSlave_sendReplyPRIV(txBuf, MODBUS_FC11_REPLY_LENGTH);
+}
+
+/*
+ ========================================================================================
+ Method name:  ModbusSlave_commEventLogPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Handles FC12 Get Comm Event Log. Replies with status and event count as
+		 FC11, the message count (MIN_SLAVE_MESSAGE_CNUM) and the events in the log,
+		 most recent first.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void ModbusSlave_commEventLogPRIV(void) {
+	uint8_t i;
+	uint8_t entry;
+	uint8_t * dataPtr;
+	uint16_t status;
+	uint16_t messageCount;
+
+	status = MinSlave_nfcBusyPRIV() ? MODBUS_COMM_STATUS_BUSY : MODBUS_COMM_STATUS_READY;
+	messageCount = pMinSlaveSelf->counters[MIN_SLAVE_MESSAGE_CNUM];
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC12;                    		// Function code
+	txBuf[MODBUS_FC12_BYTES_REPLY_INDEX] = (uint8_t)(MODBUS_FC12_FIXED_BYTES + pMinSlaveSelf->eventLogEntries);
+	txBuf[MODBUS_FC12_STATUS_INDEX - 1] = (uint8_t)(status >> 8);
+	txBuf[MODBUS_FC12_STATUS_INDEX] = (uint8_t)(status & 0xFF);
+	txBuf[MODBUS_FC12_EVENT_COUNT_INDEX - 1] = (uint8_t)(pMinSlaveSelf->eventCount >> 8);
+	txBuf[MODBUS_FC12_EVENT_COUNT_INDEX] = (uint8_t)(pMinSlaveSelf->eventCount & 0xFF);
+	txBuf[MODBUS_FC12_MESSAGE_COUNT_INDEX - 1] = (uint8_t)(messageCount >> 8);
+	txBuf[MODBUS_FC12_MESSAGE_COUNT_INDEX] = (uint8_t)(messageCount & 0xFF);
+	dataPtr = &txBuf[MODBUS_FC12_EVENTS_START_INDEX];
+	entry = pMinSlaveSelf->eventLogIndex;
+	for (i = 0; i < pMinSlaveSelf->eventLogEntries; i++) {
+		entry = (uint8_t)((entry + MIN_SLAVE_EVENT_LOG_SIZE - 1) % MIN_SLAVE_EVENT_LOG_SIZE);
+		*dataPtr++ = pMinSlaveSelf->eventLog[entry];
+	}
+	MinSlave_sendReplyPRIV(txBuf, (uint8_t)(MODBUS_FC12_EVENTS_START_INDEX + pMinSlaveSelf->eventLogEntries));
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_receiveEventPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Returns the comm event byte of the request being handled: broadcast, and
+		 overrun or communication error if the bus counters show one since the
+		 last receive event.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_receiveEventPRIV(void) {
+	uint8_t event = MODBUS_EVENT_RECEIVE;
+	uint16_t commErrors;
+	uint16_t uartCounters[MIN_UART_NUMBER_OF_COUNTERS];
+
+	MinUart_copyCounters(&pMinSlaveSelf->uart, uartCounters);
+	commErrors = uartCounters[MIN_UART_CRC_ERROR_CNUM] + uartCounters[MIN_UART_FRAMING_ERROR_CNUM];
+	if (pRxFrame[MODBUS_SLAVE_ADDRESS_INDEX] == MODBUS_MASTER_BROADCAST) {
+		event |= MODBUS_EVENT_RX_BROADCAST;
+	}
+	if (uartCounters[MIN_UART_OVERRUN_CNUM] != lastOverruns) {
+		event |= MODBUS_EVENT_RX_OVERRUN;
+	}
+	if (commErrors != lastCommErrors) {
+		event |= MODBUS_EVENT_RX_COMM_ERROR;
+	}
+	lastOverruns = uartCounters[MIN_UART_OVERRUN_CNUM];
+	lastCommErrors = commErrors;
+	return event;
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_sendEventPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Returns the comm event byte of the reply sent, from the exception code the
+		 request raised (0 = normal reply).
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_sendEventPRIV(uint8_t exceptionCode) {
+
+	if (exceptionCode == 0) {
+		return MODBUS_EVENT_SEND;
+	}
+	if (exceptionCode <= MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE) {
+		return MODBUS_EVENT_SEND | MODBUS_EVENT_SEND_READ_EXCEPTION;
+	}
+	if (exceptionCode == MODBUS_EXCEPTION_SLAVE_DEVICE_FAILURE) {
+		return MODBUS_EVENT_SEND | MODBUS_EVENT_SEND_ABORT;
+	}
+	return MODBUS_EVENT_SEND | MODBUS_EVENT_SEND_BUSY;
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_logEventPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Adds a comm event byte to the event log, the oldest event is overwritten
+		 once the log is full.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void MinSlave_logEventPRIV(uint8_t event) {
+
+	pMinSlaveSelf->eventLog[pMinSlaveSelf->eventLogIndex] = event;
+	pMinSlaveSelf->eventLogIndex = (uint8_t)((pMinSlaveSelf->eventLogIndex + 1) % MIN_SLAVE_EVENT_LOG_SIZE);
+	if (pMinSlaveSelf->eventLogEntries < MIN_SLAVE_EVENT_LOG_SIZE) {
+		pMinSlaveSelf->eventLogEntries++;
+	}
+}
+
+/*
+ ========================================================================================
+ Method name:  ModbusSlave_maskWriteRegisterPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Handles FC22 Mask Write Register as one read-modify-write done here:
+		 result = (current AND andMask) OR (orMask AND NOT andMask). An NFC register
+		 is read and only written, into the write back pages, if the result differs,
+		 so setting a bit that is already set costs no EEPROM write cycle. Exception
+		 06 when the write back pages are full. A slave register is always written
+		 so the writable check of MinSlave_writeSlaveRegisterPRIV() applies. Reply is
+		 the request echoed.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ 1.01    10-16-2026  NFC register written with NFC_bufferWrite()
+ 1.02    10-16-2026  Exception 03 for a bad slave register value, 06 when the
+					 NFC write policy refuses the write
+ 1.03    10-16-2026  NFC write counted for its policy only once taken
+ ----------------------------------------------------------------------------------------
+ */
+static void ModbusSlave_maskWriteRegisterPRIV(void) {
+	uint8_t i;
+	uint8_t putResult;
+	uint8_t stored[MODBUS_BYTES_PER_REG];
+	uint8_t exceptionCode;
+	uint16_t registerNumber;
+	uint16_t andMask;
+	uint16_t orMask;
+	uint16_t current;
+	uint16_t result;
+
+	registerNumber = MODBUS_WORD(pRxFrame, MODBUS_FC03_START_ADDR_INDEX);
+	andMask = MODBUS_WORD(pRxFrame, MODBUS_FC22_AND_MASK_INDEX);
+	orMask = MODBUS_WORD(pRxFrame, MODBUS_FC22_OR_MASK_INDEX);
+	exceptionCode = MinSlave_checkRegistersPRIV(registerNumber, 1, NFC_REGION_READ | NFC_REGION_WRITE);
+	if (exceptionCode != 0) {
+		MinSlave_sendExceptionPRIV(exceptionCode);
+		return;
+	}
+
+	if (registerNumber >= MODBUS_SLAVE_REGISTER_BASE) {	//slave register, not NFC memory
+		registerNumber = registerNumber - MODBUS_SLAVE_REGISTER_BASE;
+		current = pMinSlaveSelf->slaveRegisters[registerNumber];
+		result = (current & andMask) | (orMask & (uint16_t)~andMask);
+		putResult = MinSlave_writeSlaveRegisterPRIV(registerNumber, result);
+		if (putResult != MINSLAVE_PUT_SLAVE_DATA_SUCCESS) {
+			MinSlave_sendExceptionPRIV(MinSlave_putExceptionPRIV(putResult));
+			return;
+		}
+	}
+	else {
+		FlagEEPBusy = EEPBusy;
+		NFC_SequentialRead(registerNumber * MODBUS_BYTES_PER_REG, MODBUS_BYTES_PER_REG, stored);
+		current = ((uint16_t)stored[0] << 8) | stored[1];
+		result = (current & andMask) | (orMask & (uint16_t)~andMask);
+		FlagEEPBusy = EEPFree;
+		stored[0] = (uint8_t)(result >> 8);
+		stored[1] = (uint8_t)(result & 0xFF);
+		if (result != current) {
+			if (!NFC_writeAllowed(registerNumber * MODBUS_BYTES_PER_REG, MODBUS_BYTES_PER_REG) ||
+				(NFC_bufferWrite(registerNumber * MODBUS_BYTES_PER_REG, stored, MODBUS_BYTES_PER_REG) != NO_WRITE_ERR)) {
+				MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+				return;
+			}
+			NFC_countWrite(registerNumber * MODBUS_BYTES_PER_REG, MODBUS_BYTES_PER_REG);
+		}
+	}
+
+	for (i = 0; i < MODBUS_FC22_REPLY_LENGTH; i++) {
+		txBuf[i] = pRxFrame[i];
+	}
+	MinSlave_sendReplyPRIV(txBuf, MODBUS_FC22_REPLY_LENGTH);
+}
+
+/*
+ ========================================================================================
+ Method name:  ModbusSlave_readFifoQueuePRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Handles FC24 Read FIFO Queue of the event log, the FIFO pointer address is
+		 the register number of NFC_EVENT_LOG_OFFSET. Replies with the newest
+		 EVENT_LOG_FIFO_ENTRIES events, oldest first, two registers each: sequence
+		 number, event code and data. Events not yet written to the NFC are
+		 included.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void ModbusSlave_readFifoQueuePRIV(void) {
+	uint8_t fifoCount;
+	uint8_t byteCount;
+
+	if (MODBUS_WORD(pRxFrame, MODBUS_FC24_FIFO_ADDR_INDEX) != (NFC_EVENT_LOG_OFFSET / MODBUS_BYTES_PER_REG)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
+	}
+	if (MinSlave_nfcBusyPRIV()) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
+	}
+	FlagEEPBusy = EEPBusy;
+	fifoCount = EventLog_read(&oEventLog, &txBuf[MODBUS_FC24_DATA_START_INDEX], EVENT_LOG_FIFO_ENTRIES) * EVENT_LOG_REGS_PER_ENTRY;
 	FlagEEPBusy = EEPFree;
-	
-//	temp = registerNumber & 0x00FF;
+	byteCount = (uint8_t)(MODBUS_BYTES_PER_REG + (fifoCount * MODBUS_BYTES_PER_REG));
+
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC24;                    		// Function code
+	txBuf[MODBUS_FC24_BYTE_COUNT_INDEX - 1] = 0;
+	txBuf[MODBUS_FC24_BYTE_COUNT_INDEX] = byteCount;
+	txBuf[MODBUS_FC24_FIFO_COUNT_INDEX - 1] = 0;
+	txBuf[MODBUS_FC24_FIFO_COUNT_INDEX] = fifoCount;
+	MinSlave_sendReplyPRIV(txBuf, (uint8_t)(MODBUS_FC24_DATA_START_INDEX + (fifoCount * MODBUS_BYTES_PER_REG)));
+}
+
+/*
+ ========================================================================================
+ Method name:  ModbusSlave_readDeviceIdPRIV()
+
+ Originator:   
+
+ Description:
 
-//	(void) HardwareUart_SendChar(temp);
+ 	 	 Handles FC43 MEI type 14, Read Device Identification. ReadDevId codes 1 to 3
+		 stream the objects of deviceIdTable[] from the requested object id up to the
+		 last id of the category, an unknown object id starts from the first object.
+		 Code 4 replies with one object. Everything fits in one reply so more follows
+		 is always 0. Objects come from flash and RAM, the NFC is not used so the
+		 request is answered while an NFC write is pending.
+ Resources:
 
-//	temp = registerNumber & 0xFF00;
-//	temp = (uint8_t)(registerNumber >>8);
-//	(void) HardwareUart_SendChar(temp);
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static void ModbusSlave_readDeviceIdPRIV(void) {
+	uint8_t i;
+	uint8_t first;
+	uint8_t length;
+	uint8_t index;
+	uint8_t readDeviceIdCode;
+	uint8_t objectId;
+	uint8_t lastObjectId;
+	uint8_t numberOfObjects = 0;
+	const __flash char *pString;
+
+	if (pRxFrame[MODBUS_FC43_MEI_TYPE_INDEX] != MODBUS_MEI_READ_DEVICE_ID) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_FUNCTION);
+		return;
+	}
+	readDeviceIdCode = pRxFrame[MODBUS_FC43_READ_DEVICE_ID_CODE_INDEX];
+	objectId = pRxFrame[MODBUS_FC43_OBJECT_ID_INDEX];
+	switch (readDeviceIdCode) {
+		case MODBUS_DEVICE_ID_BASIC:
+			lastObjectId = 0x02;
+			break;
+		case MODBUS_DEVICE_ID_REGULAR:
+			lastObjectId = 0x7F;
+			break;
+		case MODBUS_DEVICE_ID_EXTENDED:
+		case MODBUS_DEVICE_ID_INDIVIDUAL:
+			lastObjectId = 0xFF;
+			break;
+		default:
+			MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+			return;
+	}
+	for (first = 0; first < DEVICE_ID_OBJECTS; first++) {
+		if (deviceIdTable[first].objectId == objectId) {
+			break;
+		}
+	}
+	if (readDeviceIdCode == MODBUS_DEVICE_ID_INDIVIDUAL) {
+		if (first >= DEVICE_ID_OBJECTS) {
+			MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+			return;
+		}
+		lastObjectId = objectId;
+	}
+	else if ((first >= DEVICE_ID_OBJECTS) || (objectId > lastObjectId)) {
+		first = 0;		// Unknown object id, stream from the start
+	}
 
+	txBuf[MODBUS_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
+	txBuf[MODBUS_FUNCTION_CODE_INDEX] = MODBUS_FC43;                    		// Function code
+	txBuf[MODBUS_FC43_MEI_TYPE_INDEX] = MODBUS_MEI_READ_DEVICE_ID;
+	txBuf[MODBUS_FC43_READ_DEVICE_ID_CODE_INDEX] = readDeviceIdCode;
+	txBuf[MODBUS_FC43_CONFORMITY_LEVEL_INDEX] = MODBUS_DEVICE_ID_CONFORMITY;
+	txBuf[MODBUS_FC43_MORE_FOLLOWS_INDEX] = 0;
+	txBuf[MODBUS_FC43_NEXT_OBJECT_ID_INDEX] = 0;
+	index = MODBUS_FC43_OBJECTS_START_INDEX;
+	for (i = first; (i < DEVICE_ID_OBJECTS) && (deviceIdTable[i].objectId <= lastObjectId); i++) {
+		txBuf[index++] = deviceIdTable[i].objectId;
+		pString = deviceIdTable[i].pString;
+		if (pString != 0) {
+			for (length = 0; pString[length] != '\0'; length++) {
+				txBuf[index + 1 + length] = (uint8_t)pString[length];
+			}
+		}
+		else {
+			length = deviceIdTable[i].getObject(&txBuf[index + 1]);
+		}
+		txBuf[index++] = length;
+		index = index + length;
+		numberOfObjects++;
+	}
+	txBuf[MODBUS_FC43_NUMBER_OF_OBJECTS_INDEX] = numberOfObjects;
+	MinSlave_sendReplyPRIV(txBuf, index);
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_putHexPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Writes the low digits of value to pDest as upper case hex ASCII, most
+		 significant first. Returns the number of characters written.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_putHexPRIV(uint8_t *pDest, uint16_t value, uint8_t digits) {
+	uint8_t i;
+	uint8_t nibble;
+
+	for (i = digits; i > 0; i--) {
+		nibble = (uint8_t)(value & 0x0F);
+		pDest[i - 1] = (nibble < 10) ? (uint8_t)('0' + nibble) : (uint8_t)('A' + nibble - 10);
+		value = value >> 4;
+	}
+	return digits;
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_getFirmwareRevisionPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Device identification object 0x02, firmware revision as "V.RR.BB" from
+		 VERSION, REVISION and BUILDREVISION in Version.h.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_getFirmwareRevisionPRIV(uint8_t *pDest) {
+	uint8_t length;
+
+	length = MinSlave_putHexPRIV(pDest, VERSION, (VERSION > 0x0F) ? 2 : 1);
+	pDest[length++] = '.';
+	length = length + MinSlave_putHexPRIV(&pDest[length], REVISION, 2);
+	pDest[length++] = '.';
+	length = length + MinSlave_putHexPRIV(&pDest[length], BUILDREVISION, 2);
+	return length;
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_getConfigCodePRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Device identification object 0x05, the model configuration code slave
+		 register as 4 hex characters.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_getConfigCodePRIV(uint8_t *pDest) {
+	return MinSlave_putHexPRIV(pDest, pMinSlaveSelf->slaveRegisters[MIN_SLAVE_MODEL_CONFIGURATION_CODE], 4);
+}
+
+/*
+ ========================================================================================
+ Method name:  MinSlave_getHardwareRevisionPRIV()
+
+ Originator:   
+
+ Description:
+
+ 	 	 Device identification object 0x80, hardware revision as "V.RR" from
+		 CURRENT_HW_VERSION and CURRENT_HW_REVISION in Build.h.
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+ ----------------------------------------------------------------------------------------
+ */
+static uint8_t MinSlave_getHardwareRevisionPRIV(uint8_t *pDest) {
+	uint8_t length;
+
+	length = MinSlave_putHexPRIV(pDest, CURRENT_HW_VERSION, (CURRENT_HW_VERSION > 0x0F) ? 2 : 1);
+	pDest[length++] = '.';
+	length = length + MinSlave_putHexPRIV(&pDest[length], CURRENT_HW_REVISION, 2);
+	return length;
 }
 
 /*
@@ -1235,37 +2400,44 @@ static void ModbusSlave_replyRegisterRequestPRIV(void) {
  1.02    08-28-2020  Modified to reply with ProductInfoNVM crc		  Anish Venkataraman
  1.03    08-28-2020  Restructured code, removed reference to		  Anish Venkataraman\
 					 ProductInfoNVMSTYP.
+ 1.04    10-16-2026  Product info left in frame buffer for NFC write
+ 1.05    10-16-2026  Exception 06 when NFC is busy
+ 1.06    10-16-2026  Exception 02 when product info does not fit its region
+ 1.07    10-16-2026  Exception 06 when the NFC write policy refuses the write
+ 1.08    10-16-2026  Write counted for its policy only once taken
  ----------------------------------------------------------------------------------------
  */
 static void MinSlave_storeProductInfoPRIV(void) {
 	uint8_t i;
 	uint8_t * dataPtr;
-	uint16_t crc;
 	uint8_t index = 0;
 	if(pMinSlaveSelf == 0) {
 		return;
 	}
-	//Save productInfoLength
-	oNFC.productInfoLength = pMinSlaveSelf->uart.rxBuffer[MIN_FC70_BYTES_TO_RX_INDEX] - MIN_FC70_PAYLOAD;
-	//Save the Initialized Variable
-	for(i = 0; i < oNFC.productInfoLength; i++) {
-		oNFC.productInfoData[i] = pMinSlaveSelf->uart.rxBuffer[MIN_FC70_DATA_START_INDEX+i];
+	if (!NFC_checkAccess(BLOCK_NVM_OFFSET, pRxFrame[MIN_FC70_BYTES_TO_RX_INDEX] - MIN_FC70_PAYLOAD, NFC_REGION_WRITE)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
+	}
+	if (MinSlave_nfcBusyPRIV() || !NFC_writeAllowed(BLOCK_NVM_OFFSET, pRxFrame[MIN_FC70_BYTES_TO_RX_INDEX] - MIN_FC70_PAYLOAD)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
 	}
+	NFC_countWrite(BLOCK_NVM_OFFSET, pRxFrame[MIN_FC70_BYTES_TO_RX_INDEX] - MIN_FC70_PAYLOAD);
+	//Save productInfoLength
+	oNFC.productInfoLength = pRxFrame[MIN_FC70_BYTES_TO_RX_INDEX] - MIN_FC70_PAYLOAD;
+	//Product info stays in the frame buffer until the Scheduler has written it
+	oNFC.pProductInfoData = &pRxFrame[MIN_FC70_DATA_START_INDEX];
+	pMinSlaveSelf->pHandedOffFrame = pRxFrame;
 	// Reply is required for specific slave writing of registers. Reply is same as request for first 6 bytes received
-	dataPtr = &pMinSlaveSelf->uart.rxBuffer[MIN_SLAVE_ADDRESS_INDEX];
+	dataPtr = &pRxFrame[MIN_SLAVE_ADDRESS_INDEX];
 	for(i = 0; i < 2; i++){
 		txBuf[index++] = *dataPtr++;
 	}
 	//update the config code sent from master MSB byte << 8 + LSB byte
-	pMinSlaveSelf->slaveRegisters[MIN_SLAVE_MODEL_CONFIGURATION_CODE] = (((uint16_t)oNFC.productInfoData[oNFC.productInfoLength - 3] << 8) | (uint16_t)oNFC.productInfoData[oNFC.productInfoLength - 4]);
-	txBuf[index++] = oNFC.productInfoData[oNFC.productInfoLength - 2];//CRC LSB
-	txBuf[index++] = oNFC.productInfoData[oNFC.productInfoLength - 1];//CRC MSB
-	crc = get_crc_16 (0xFFFF, txBuf, index);         // Calculate the CRC to send with reply slaveAddr
-	txBuf[index++] = (uint8_t) (crc & 0xff);             // CRCL
-	txBuf[index++] = (uint8_t) (crc >> 8);               // CRCH
+	pMinSlaveSelf->slaveRegisters[MIN_SLAVE_MODEL_CONFIGURATION_CODE] = (((uint16_t)oNFC.pProductInfoData[oNFC.productInfoLength - 3] << 8) | (uint16_t)oNFC.pProductInfoData[oNFC.productInfoLength - 4]);
+	txBuf[index++] = oNFC.pProductInfoData[oNFC.productInfoLength - 2];//CRC LSB
+	txBuf[index++] = oNFC.pProductInfoData[oNFC.productInfoLength - 1];//CRC MSB
 	
-	// Enable the Tx line
-	minTxEnable();
 
 	// Send reply
 	MinSlave_sendReplyPRIV(txBuf, index);
@@ -1292,33 +2464,42 @@ static void MinSlave_storeProductInfoPRIV(void) {
  1.00    07-07-2020  Original code									  Anish Venkataraman
  1.01    05-10-2021  Modified code to support requested length		  Anish Venkataraman
 					 instead of a fixed macro.
+ 1.02    10-16-2026  Read straight into txBuf, up to 125 registers
+ 1.03    10-16-2026  Exception 06 when NFC is busy
+ 1.04    10-16-2026  Exception 03 for bad quantity, 02 outside NFC memory
+ 1.05    10-16-2026  Pending product info write included, not busy while only
+					 pending
  ----------------------------------------------------------------------------------------
  */
 static void MinSlave_getProductInfoPRIV(void) {
-	uint8_t i;
 	uint8_t * dataPtr;
-	uint8_t readBuf[NFC_MAX_MEM];	//array to store read data
 	uint8_t length;
-	uint16_t crc;
 	uint8_t txLength;
+	// 125 registers is the most that fits in a Modbus reply frame
+	if ((pRxFrame[MIN_FC69_DATA_LENGTH_INDEX] == 0) || (pRxFrame[MIN_FC69_DATA_LENGTH_INDEX] > MODBUS_FC03_MAX_REGISTERS)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE);
+		return;
+	}
+	if (!NFC_checkAccess(BLOCK_NVM_OFFSET, pRxFrame[MIN_FC69_DATA_LENGTH_INDEX] * MODBUS_BYTES_PER_REG, NFC_REGION_READ)) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS);
+		return;
+	}
+	if (MinSlave_nfcReadBusyPRIV()) {
+		MinSlave_sendExceptionPRIV(MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY);
+		return;
+	}
 	txBuf[MIN_SLAVE_ADDRESS_INDEX] = pMinSlaveSelf->uart.moduleAddress;  	// Slave address
 	txBuf[MIN_FUNCTION_CODE_INDEX] = MIN_FC69_GET_PRODUCT_INFO;            // Function code
-	txBuf[MIN_FC69_BYTES_TO_RX_INDEX] =  pMinSlaveSelf->uart.rxBuffer[MIN_FC69_DATA_LENGTH_INDEX] * 2; // no. of registers * bytes per reg(2)
-	length =  pMinSlaveSelf->uart.rxBuffer[MIN_FC69_DATA_LENGTH_INDEX] * 2;
+	txBuf[MIN_FC69_BYTES_TO_RX_INDEX] =  pRxFrame[MIN_FC69_DATA_LENGTH_INDEX] * 2; // no. of registers * bytes per reg(2)
+	length =  pRxFrame[MIN_FC69_DATA_LENGTH_INDEX] * 2;
 	//set poitner to tx buffer
 	dataPtr = &txBuf[MIN_FC69_DATA_START_INDEX];
 	//read NFC memory
-	NFC_SequentialRead(BLOCK_NVM_OFFSET,length,readBuf);
-	for(i = 0; i < length; i++) {
-		*dataPtr++ = readBuf[i];
-	}
-	//calculate crc 
-	crc = get_crc_16 (0xFFFF, txBuf, MIN_FC69_DATA_START_INDEX + length);// Calculate the CRC to send with reply
-	*dataPtr++ = (uint8_t) (crc & 0xff);   // CRCL
-	*dataPtr = (uint8_t) (crc >> 8); // CRCH
-	txLength = (MIN_FC03_DATA_START + length + MIN_CRC_LENGTH);
-	// Enable the Tx line
-	minTxEnable();
+	FlagEEPBusy = EEPBusy;
+	NFC_SequentialRead(BLOCK_NVM_OFFSET,length,dataPtr);	//Read straight into txBuf
+	FlagEEPBusy = EEPFree;
+	NFC_overlayPending(&oNFC, BLOCK_NVM_OFFSET, dataPtr, length);
+	txLength = (MIN_FC03_DATA_START + length);
 	// Send reply
 	MinSlave_sendReplyPRIV(txBuf, txLength);
 }
@@ -25,12 +25,27 @@ Use:
 	Tx buffer before enabling the UART so the output buffer must be sized for the maximum
 	reply length which is likely the slave register broadcast message.
 
-	MinSlave_Manage() must be called by OnRxChar() interrupt to insure response to poll request
-	meets the 30 msec specification.
+	MinSlave_serviceRx() is called by the receive interrupt and only does the framing.
+	MinSlave_manageMessages() is called every pass of the MyMain_main() loop and does the
+	processing and reply, so the main loop must get back to it well within the 30 msec
+	response specification.
+
+	The receive interrupt writes into one of two frame slots, uart.frame[], used in turn
+	so a request can be received while the previous one is handled. A complete message
+	belongs to MinSlave from MinUart_getFrame() until it is released. FC16 and FC70 data
+	is not copied, the NFC object is given a pointer into the frame and the Scheduler
+	calls MinSlave_releaseFrame() once the data is written to the NFC.
+
+	While the Scheduler waits for an NFC page write it calls MinSlave_manageMessages(),
+	so requests are still answered within the response time. Requests that need the
+	NFC while a write is pending get exception 06 (Slave Device Busy), an FC16 write
+	to the NFC that takes longer than the response time is answered with exception
+	05 (Acknowledge) instead of the normal reply.
 
 	At 115,200 baud (max bus speed)	though that represents 113 characters. Therefore the buffer size must
 	take the frequency of characters coming and the delay between calls to MinSlave_Manage().
 
+	The reply is sent from the UART transmit buffer by the Data Register Empty interrupt.
 	When the low level interrupt  see a completed transmission, it calls MinUart_ServiceTx().
 	This is only a few lines of code to handle the UART and TxEna pin so is done in the interrupt
 	itself.
@@ -43,7 +58,9 @@ Multi-Instance: No
  
 Class Methods:
   	MinSlave_init();
+	MinSlave_serviceRx();
 	MinSlave_ManageMessage();
+	MinSlave_releaseFrame();
 	MinGetData();
 	void MinSlave_SetScratchPadData();
 
@@ -52,11 +69,11 @@ Resources:
 	IoTranslate Requirements:
 
 	HardwareUart_RxOff()            // Disables UART from receiving characters
-	HardwareUart_SendChar()         // Sends one character out UART
-	minTxEnable()                   // Sets TxEnable digital output
+	HardwareUart_SendChar()         // Queues one character to send out UART
+	minTxEnable()                   // Sets TxEnable digital output (from IoTranslate when reply turnaround elapsed)
 	minRxEnable()                   // Clears TxEnable digital output
 	HardwareUart_GetCharsInRxBuf()  // Get number of characters in the receive buffer.
-	WAIT_MSEC()						// For wait macro for 2 msec replay delay
+	MinTurnAroundStart()			// Reply turnaround timer, started by MinUart at end of request
 =======================================================================================
  History:	
 -*-----*------------*---------------------------------------------------*--------------
@@ -65,6 +82,25 @@ Resources:
 					default to ONE_SECOND_TIME.					
 1.02	08-17-2020  Added slave specific register and modified the	 Anish Venkataraman
 					max baudrate enum to appl1cation, and defaults updated
+1.03	10-16-2026	Added MinSlave_serviceRx(), message processing moved
+					to main loop
+1.04	10-16-2026	Added MIN_SLAVE_TURNAROUND_USEC_RNUM and
+					MODBUS_SLAVE_REGISTER_BASE
+1.05	10-16-2026	Added frameHandedOffFLG and MinSlave_releaseFrame()
+1.06	10-16-2026	Messages received into two frame slots
+1.07	10-16-2026	pHandedOffFrame replaces frameHandedOffFLG, requests
+					answered with exception 05/06 while the NFC is busy
+1.08	10-16-2026	Added slave counters read as input registers (FC04)
+1.09	10-16-2026	Added DeviceIdObject_STYP for FC43/14 Read Device
+					Identification
+1.10	10-16-2026	Added no response counter and comm event log for
+					FC08/FC11/FC12 diagnostics, bus counters read as input
+					registers
+1.11	10-16-2026	Added MIN_SLAVE_REPLY_LEAD for streamed replies
+1.12	10-16-2026	Added NFC write policy registers, MinSlave_putSlaveData()
+					invalid value and busy returns
+1.13	10-16-2026	Added NFC region digest registers
+1.14	10-16-2026	Added MIN_SLAVE_LINE_FILL_USEC, streamed reply lead sized from it
 ---------------------------------------------------------------------------------------
 */
 
@@ -94,10 +130,46 @@ enum slaveRegisterNumbers {
   MIN_SLAVE_RESERVED15_RNUM,
   //Slave specific registers
   MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM,
+  MIN_SLAVE_TURNAROUND_USEC_RNUM,				// Reply turnaround in usec, 0 = t3.5 (default)
+  MIN_SLAVE_POLICY_INTERVAL_RNUM,				// Minutes per NFC_POLICY_RATE_LIMITED interval, 0 = 1
+  MIN_SLAVE_REGION0_POLICY_RNUM,				// NFC_POLICY_ON_CHANGE.. << NFC_POLICY_SHIFT | writes per interval,
+  MIN_SLAVE_REGION1_POLICY_RNUM,				// one register per region of nfcRegionTable[] in NFC.c,
+  MIN_SLAVE_REGION2_POLICY_RNUM,				// saved in the NFC by NFC_savePolicy()
+  MIN_SLAVE_REGION3_POLICY_RNUM,
+  MIN_SLAVE_REGION4_POLICY_RNUM,
+  MIN_SLAVE_REGION0_DIGEST_RNUM,				// Read only CRC-16 (Modbus) of each region of nfcRegionTable[]
+  MIN_SLAVE_REGION1_DIGEST_RNUM,				// as the NFC holds it, see NFC_digestUpdate()
+  MIN_SLAVE_REGION2_DIGEST_RNUM,
+  MIN_SLAVE_REGION3_DIGEST_RNUM,
+  MIN_SLAVE_REGION4_DIGEST_RNUM,
+  MIN_SLAVE_REGION5_DIGEST_RNUM,
+  MIN_SLAVE_REGION6_DIGEST_RNUM,
   MIN_SLAVE_NUMBER_OF_REGISTERS
   
 };
 
+// List of slave counters, read only live state read as input registers (FC04)
+enum slaveCounterNumbers {
+  MIN_SLAVE_MESSAGE_CNUM = 0,					// Requests handled, including broadcasts
+  MIN_SLAVE_EXCEPTION_CNUM,						// Exception replies sent
+  MIN_SLAVE_BUSY_CNUM,							// Exception 06 replies sent, NFC was busy
+  MIN_SLAVE_NO_RESPONSE_CNUM,					// Requests not replied to (broadcasts)
+  MIN_SLAVE_NUMBER_OF_COUNTERS
+};
+
+// Reply characters queued before the reply is armed, see MinSlave_replyBytePRIV().
+// A reply streamed from the NFC is armed later, see MinSlave_streamLeadPRIV().
+#define MIN_SLAVE_REPLY_LEAD		16U
+
+// Worst case time to fill one NFC read cache line over the bit-banged I2C bus: address
+// phase and NFC_CACHE_LINE_SIZE data bytes, about 20 I2C bytes. Assumes SCL no slower
+// than 100 kHz (20 x 9 bits x 10 usec) at F_CPU 20 MHz, the bus runs faster; if the
+// I2C delay or clock is changed measure the line fill and update this.
+#define MIN_SLAVE_LINE_FILL_USEC	1800U
+
+// Comm event log (FC12), last MIN_SLAVE_EVENT_LOG_SIZE events kept in RAM
+#define MIN_SLAVE_EVENT_LOG_SIZE	16U
+
 
 //CLASS OBJECT DEFINITION
 
@@ -116,7 +188,13 @@ typedef struct MinSlave_STYP{
     bool validCommunicationReceivedFLG;	//signal communication is still active.
     bool delayDoneFLG;		  			// Set by interrupt.
     bool updateConfigurationsFLG;		// Set when new slave command to change a slave parameter received.
+    uint8_t *pHandedOffFrame;			// Frame used by NFC write, released by MinSlave_releaseFrame() after the write.
     uint16_t slavePollBroadcastInterval; // Number of calls between broadcasts.
+    uint16_t counters[MIN_SLAVE_NUMBER_OF_COUNTERS];	// See slaveCounterNumbers, wrap around at 0xFFFF
+    uint16_t eventCount;				// Comm event counter (FC11), requests completed without exception
+    uint8_t eventLogIndex;				// Next entry of eventLog[] written
+    uint8_t eventLogEntries;			// Entries of eventLog[] written, up to MIN_SLAVE_EVENT_LOG_SIZE
+    uint8_t eventLog[MIN_SLAVE_EVENT_LOG_SIZE];	// Comm events (FC12), ring buffer
 // Component class
     struct MinUart_STYP uart;
 
@@ -124,7 +202,9 @@ typedef struct MinSlave_STYP{
 
 //  PUBLIC CLASS METHOD PROTOTYPES DECLARATION
 void MinSlave_init(struct MinSlave_STYP *minSlave);                                                              	// Initialize any variables
+void MinSlave_serviceRx(void);																				// Receive ISR framing
 void MinSlave_manageMessages();                                                    						  	// MIN message processing
+void MinSlave_releaseFrame(void);																			// Frame buffer free for next message
 uint8_t MinSlave_setupSetpointChange(uint8_t block, uint8_t registerNum, uint16_t *pData, uint8_t numRegs); // Called to setup change in a setpoint in the master (controller).
 uint8_t MinSlave_getMasterData(uint8_t block, uint8_t reg, uint16_t *returnDataW);                        	// Getter function for MIN Master registers
 uint8_t MinSlave_getSlaveData(uint8_t reg, uint16_t *returnDataW);                                        	// Getter function for MIN slave registers
@@ -142,16 +222,42 @@ uint8_t MinSlave_putSlaveData(uint8_t index, uint16_t dataW);
 		CURRENT_HW_VERSION_REVISION,	\
 		BUILDREVISION,					\
 		0,								\
-		0,0,0,0,0,0,0,0,0},				\
+		0,0,0,0,0,0,0,0,0,0,			\
+		0,0,0,0,0,0,					\
+		0,0,0,0,0,0,0},					\
 		ONE_SECOND_TIME,				\
-		0,0,((void*)0),0,0,0,0,0,		\
-		ONE_SECOND_TIME
+		0,0,((void*)0),0,0,0,0,0,((void*)0),	\
+		ONE_SECOND_TIME,				\
+		{0},							\
+		0,0,0,{0}
 
 #define MIN_DEFAULTS    {MIN_SLAVE_DEFAULTS,  \
 		                 MIN_UART_DEFAULTS    \
 						}
 
 
+// Slave registers are read (FC03) and written (FC06) by Modbus register number
+// MODBUS_SLAVE_REGISTER_BASE + slave register number. Lower register numbers are NFC memory.
+#define MODBUS_SLAVE_REGISTER_BASE	0xF000U
+
+// Input registers (FC04) are slave register n at register number n, slave counter n
+// at MODBUS_INPUT_COUNTER_BASE + n and bus counter n (uartCounterNumbers) at
+// MODBUS_INPUT_UART_COUNTER_BASE + n. Only read with FC04, not written.
+#define MODBUS_INPUT_COUNTER_BASE	0x0100U
+#define MODBUS_INPUT_UART_COUNTER_BASE	0x0110U
+
+// Read Device Identification (FC43/14) object. The value is the flash string pString or,
+// if it is 0, is written to pDest by getObject() which returns its length. No NFC access.
+typedef struct DeviceIdObject_STYP{
+	uint8_t objectId;
+	const __flash char *pString;
+	uint8_t (*getObject)(uint8_t *pDest);
+} DeviceIdObject_STYP;
+#define MODBUS_DEVICE_ID_CONFORMITY	0x83U	// Basic, regular and extended, stream and individual access
+
+// Master response time out. An NFC write that takes longer is answered with exception 05.
+#define MODBUS_RESPONSE_TIME_MSEC	30U
+
 // DEFINE BLOCK NUMBERS.
 #define NUMBER_OF_BLOCKS 254
 
@@ -194,6 +300,8 @@ enum {
 enum {
 	MINSLAVE_PUT_SLAVE_DATA_SUCCESS = 0,
 	MINSLAVE_PUT_SLAVE_DATA_FAIL_INVALID_REGISTER,
+	MINSLAVE_PUT_SLAVE_DATA_FAIL_INVALID_VALUE,
+	MINSLAVE_PUT_SLAVE_DATA_FAIL_BUSY,
 };
 
 // MIN Communications fault response, 0 - do nothing, 1 - clear fault,  2 - set fault
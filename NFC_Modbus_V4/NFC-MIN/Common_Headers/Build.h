@@ -33,6 +33,8 @@ Other requirements:
                     and TRUE.
 1.07	08-29-2019  Added NFC_BASE_ADDRESS as 2 and changed the         Anish Venkataraman
                     corresponding NFC_SLAVE_ADDRESS.
+1.08	10-16-2026  Added RS485_XDIR_MODE
+1.09	10-16-2026  Added DEVICE_ID_VENDOR_NAME and DEVICE_ID_PRODUCT_CODE
 ---------------------------------------------------------------------------------------
 */
 
@@ -53,6 +55,12 @@ typedef unsigned char byte;
 #define TRUE 1
 #endif
 
+// RS-485 driver enable control.
+// 0 = software, Tx_Enable (PA6) set/cleared by minTxEnable()/minRxEnable().
+// 1 = USART external RS-485 mode, hardware drives XDIR (PA4, alternate USART0 pin
+//     mux) high for exactly the frame duration. Transceiver DE must be wired to PA4.
+#define RS485_XDIR_MODE 0
+
 #include "IoTranslate.h"
 		
 #define SCHEDULER_RUN_50MSEC_TASKS		50u 	
@@ -84,6 +92,10 @@ enum {
 
 #define MAX_BAUD_RATE_SUPPORTED  BR_SELECT_115200
 
+// Read Device Identification (FC43/14) strings
+#define DEVICE_ID_VENDOR_NAME	"AOS"
+#define DEVICE_ID_PRODUCT_CODE	"NFC-MIN"
+
 // ---------------------------------------------------------------------------------
 
 
@@ -10,6 +10,23 @@ Originator:		Anish Venkataraman
 1.00	11-04-2019	New File										   Anish Venkataraman
 1.01	11-04-2019	Added I2C and UART functions		 			   Anish Venkataraman
 1.02	12-09-2019	Removed change of baud rate module	 			   Anish Venkataraman
+1.03	10-16-2026	USART_RxChar(), USART_GetCharsInRxBuf(), USART_StoreData(),
+					USART_ClearRxBuffer(): receive buffer is now a single
+					producer/single consumer ring buffer, no clearing
+1.04	10-16-2026	Added FrameTimer_start(), FrameTimer_reload() and
+					FrameTimer_stop()
+1.05	10-16-2026	USART_SendChar(), USART_SetTxInterrupt(): transmit
+					through ring buffer drained by USART_ServiceTx()
+					from Data Register Empty ISR. Added USART_TxBufEmpty()
+1.06	10-16-2026	USART_SendChar(), USART_SetTxInterrupt(): reply held
+					until turnaround elapsed. Added Turnaround_start(),
+					Turnaround_elapsed() and USART_EndTx()
+1.07	10-16-2026	USART_RxChar(), USART_GetCharsInRxBuf(),
+					USART_ClearRxBuffer(): read the USART receive data
+					register directly, removed receive ring buffer and
+					USART_StoreData()
+1.08	10-16-2026	USART_RxChar(): reports overrun and framing error
+1.09	10-16-2026	USART_SendChar(): ring holds a whole reply, 255 characters
 -----------------------------------------------------------------------------------------
  */
 
@@ -17,13 +34,24 @@ Originator:		Anish Venkataraman
 #include "stdint.h"
 #include "IoTranslate.h"
 #include "atmel_start_pins.h"
-#include "string.h"
 
 //Global Variables
-uint8_t rxChars = 0;
-uint8_t rxBuffer[RX_BUFFER_LENGTH] = {0};
-uint8_t rxIndex = 0;
-uint8_t tempIndex = 0;
+// Received characters are not buffered here, the receive ISR hands each character
+// straight to MinUart_serviceRx() which stores it in the Modbus frame buffer.
+// Transmit ring buffer.  txHead and txTail are free running 8 bit counters, only the
+// main loop writes txHead and only the Data Register Empty ISR writes txTail, so no
+// critical section is needed. It holds TX_BUFFER_LENGTH - 1 characters, a whole
+// reply (at most 3 + 250 data + 2 CRC), so queuing a reply never waits.
+uint8_t txBuffer[TX_BUFFER_LENGTH] = {0};
+volatile uint8_t txHead = 0;
+volatile uint8_t txTail = 0;
+// Reply turnaround. A queued reply is armed by USART_SetTxInterrupt() and only released
+// (driver enabled, Data Register Empty interrupt on) once the turnaround timer has elapsed.
+volatile uint8_t turnaroundDone = TRUE;
+volatile uint8_t txArmed = FALSE;
+volatile uint8_t txReleased = FALSE;
+
+static void USART_StartTxPRIV(void);
 
 /*
  ========================================================================================
@@ -104,8 +132,12 @@ void Hardware_Delay(int val) {
  Originator:   Anish Venkataraman
 
  Description:
- 	 	 This routine stores the value from the receive buffer and returns ERR or NO_ERR
-		 if there are no cahrachters inside receive buffer.  
+ 	 	 This routine stores the value from the USART receive data register and
+		 returns ERR if no character has been received, RX_OVERRUN or
+		 RX_FRAME_ERROR if the USART flagged the character, or NO_ERR.
+		 RXDATAH holds the error flags of the character and is read before
+		 RXDATAL. Reading RXDATAL clears the receive complete flag once the USART
+		 receive FIFO is empty.
 
  Resources:
 
@@ -113,24 +145,28 @@ void Hardware_Delay(int val) {
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    11-04-2019  Original code                                     Anish Venkataraman
+ 1.01    10-16-2026  Read from ring buffer, removed memset on underflow
+ 1.02    10-16-2026  Read from USART receive data register
+ 1.03    10-16-2026  Return overrun and framing error from RXDATAH
 
  ----------------------------------------------------------------------------------------
  */
 uint8_t USART_RxChar(byte *val) {
+	uint8_t status;
 
-	if(rxChars > 0) {
-		rxChars -= 1;
-		*val = rxBuffer[tempIndex];
-		tempIndex++;
-	}
-	else {
+	if((USART0.STATUS & USART_RXCIF_bm) == 0) {
 		*val = 0;
-		tempIndex = 0;
-		rxIndex = 0;
-		memset(rxBuffer, 0, RX_BUFFER_LENGTH);
 		return ERR;
 	}
+	status = USART0.RXDATAH;
+	*val = USART0.RXDATAL;
 
+	if(status & USART_BUFOVF_bm) {
+		return RX_OVERRUN;
+	}
+	if(status & USART_FERR_bm) {
+		return RX_FRAME_ERROR;
+	}
 	return NO_ERR;
 }
 
@@ -142,7 +178,8 @@ uint8_t USART_RxChar(byte *val) {
  Originator:   Anish Venkataraman
 
  Description:
- 	 	 This routine returns the number of characters in receive buffer. 
+ 	 	 This routine returns 1 if a character is waiting in the USART receive
+		 data register, otherwise 0.
 
  Resources:
 
@@ -150,22 +187,24 @@ uint8_t USART_RxChar(byte *val) {
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    11-04-2019  Original code                                     Anish Venkataraman
+ 1.01    10-16-2026  Count is difference of ring buffer head and tail
+ 1.02    10-16-2026  Checks USART receive complete flag
 
  ----------------------------------------------------------------------------------------
  */
 
 uint8_t USART_GetCharsInRxBuf(void){
-	return rxChars;
+	return (USART0.STATUS & USART_RXCIF_bm) ? 1 : 0;
 }
 
 /*
  ========================================================================================
- Method name:  USART_StoreData()
+ Method name:  USART_ClearRxBuffer()
 
  Originator:   Anish Venkataraman
 
  Description:
- 	 	 This routine stores the data received on the Rx line into a buffer.
+ 	 	 This routine discards all characters in the USART receive FIFO.
 
  Resources:
 
@@ -173,32 +212,30 @@ uint8_t USART_GetCharsInRxBuf(void){
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    11-04-2019  Original code                                     Anish Venkataraman
+ 1.01    10-16-2026  Discard by moving tail to head, no memset
+ 1.02    10-16-2026  Discard by reading USART receive data register
 
  ----------------------------------------------------------------------------------------
  */
-
-void USART_StoreData(void) {
-	if(USART0.STATUS & USART_RXCIF_bm) { //checks if the interrupt flag is set
-		byte data = USART0.RXDATAL;		//stores data 
-		USART0.STATUS = USART_RXCIF_bm;	//clears the the receive interrupt status bit
-		if(rxIndex <= RX_BUFFER_LENGTH){
-			rxBuffer[rxIndex++] = data;
-			rxChars += 1;					//increments the receive charachter
-		}
-		else{
-			rxIndex = 0;
-		}
+void USART_ClearRxBuffer(void) {
+	while(USART0.STATUS & USART_RXCIF_bm) {
+		(void)USART0.RXDATAL;
 	}
 }
 
 /*
  ========================================================================================
- Method name:  USART_ClearRxBuffer()
+ Method name:  USART_SendChar()
 
  Originator:   Anish Venkataraman
 
  Description:
- 	 	 This routine clears the receive buffer and all other component associated with it.
+ 	 	 This routine puts a character in the transmit ring buffer, USART_ServiceTx()
+		 writes it on the Tx Line from the Data Register Empty interrupt. The buffer
+		 holds the largest reply so it is not full while a reply is queued; should it
+		 be, the reply is armed so it starts once the turnaround has elapsed and this
+		 waits for room. Called from the main loop only (producer side of the ring
+		 buffer).
 
  Resources:
 
@@ -206,38 +243,81 @@ void USART_StoreData(void) {
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    11-04-2019  Original code                                     Anish Venkataraman
+ 1.01    10-16-2026  Store into transmit ring buffer
+ 1.02    10-16-2026  Arm reply when buffer full instead of sending
+ 1.03    10-16-2026  Full at TX_BUFFER_LENGTH - 1 characters
 
  ----------------------------------------------------------------------------------------
  */
-void USART_ClearRxBuffer(void) {
-	memset(rxBuffer, 0, RX_BUFFER_LENGTH);
-	rxChars = 0;
-	rxIndex = 0;
-	tempIndex = 0;
+void USART_SendChar(byte *str) {
+	uint8_t head = txHead;
+
+	if ((uint8_t)(head - txTail) >= TX_BUFFER_MASK) {
+		USART_SetTxInterrupt();			//buffer full, send it once turnaround elapsed
+		while ((uint8_t)(head - txTail) >= TX_BUFFER_MASK);
+	}
+	txBuffer[head & TX_BUFFER_MASK] = *str;
+	txHead = head + 1;					//Publish after the character has been stored
+	if (txReleased) {
+		USART0.CTRLA |= USART_DREIE_bm;	//already sending, make sure it is being drained
+	}
 }
 
 /*
  ========================================================================================
- Method name:  USART_SendChar()
+ Method name:  USART_ServiceTx()
 
- Originator:   Anish Venkataraman
+ Originator:   
 
  Description:
- 	 	 This routine writes a character on the Tx Line. This is a non-blocking routine
-		 until the Data Register Empty Flag is set.
+ 	 	 This routine writes the next character of the transmit ring buffer on the Tx
+		 Line. Called from the Data Register Empty ISR (consumer side of the ring
+		 buffer), disables the interrupt once the buffer is empty.
 
  Resources:
 
  ========================================================================================
  History:
  *-------*-----------*---------------------------------------------------*---------------
- 1.00    11-04-2019  Original code                                     Anish Venkataraman
+ 1.00    10-16-2026  Original code
 
  ----------------------------------------------------------------------------------------
  */
-void USART_SendChar(byte *str) {
-	while (!(USART0.STATUS & USART_DREIF_bm));
-	USART0.TXDATAL = *str;
+void USART_ServiceTx(void) {
+	uint8_t tail = txTail;
+
+	if(tail == txHead) {
+		USART0.CTRLA &= ~USART_DREIE_bm;	//nothing more to send
+		return;
+	}
+	USART0.TXDATAL = txBuffer[tail & TX_BUFFER_MASK];
+	txTail = tail + 1;
+	if(txTail == txHead) {
+		USART0.CTRLA &= ~USART_DREIE_bm;	//last character is in the transmit buffer
+	}
+}
+
+/*
+ ========================================================================================
+ Method name:  USART_TxBufEmpty()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine returns TRUE when all characters of the transmit ring buffer
+		 have been handed to the USART.
+
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+uint8_t USART_TxBufEmpty(void) {
+	return (txHead == txTail);
 }
 
 /*
@@ -247,8 +327,9 @@ void USART_SendChar(byte *str) {
  Originator:   Anish Venkataraman
 
  Description:
- 	 	 This routine writes a character on the Tx Line. This is a non-blocking routine
-		 until the Data Register Empty Flag is set.
+ 	 	 This routine arms the reply queued in the transmit ring buffer. If the
+		 turnaround time after the request has elapsed it is sent right away, else
+		 Turnaround_elapsed() sends it from the TCB1 interrupt.
 
  Resources:
 
@@ -256,11 +337,192 @@ void USART_SendChar(byte *str) {
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    11-04-2019  Original code                                     Anish Venkataraman
+ 1.01    10-16-2026  Enables Data Register Empty interrupt
+ 1.02    10-16-2026  Wait for turnaround
 
  ----------------------------------------------------------------------------------------
  */
 void USART_SetTxInterrupt(void) {
-	USART0.STATUS |= (1<<USART_TXCIE_bp); 
+	txArmed = TRUE;
+	if (turnaroundDone) {
+		USART_StartTxPRIV();
+	}
+}
+
+/*
+ ========================================================================================
+ Method name:  USART_StartTxPRIV()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine enables the RS-485 driver and the Data Register Empty interrupt
+		 to send the transmit ring buffer. Can be called both from main loop and
+		 TCB1 interrupt, doing it twice is harmless.
+
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+static void USART_StartTxPRIV(void) {
+	minTxEnable();
+	txReleased = TRUE;
+	USART0.CTRLA |= USART_DREIE_bm;
+}
+
+/*
+ ========================================================================================
+ Method name:  USART_EndTx()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine clears the armed reply once the transmission is complete.
+		 Called from the transmit complete ISR.
+
+ Resources:
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+void USART_EndTx(void) {
+	txArmed = FALSE;
+	txReleased = FALSE;
+}
+
+/*
+ ========================================================================================
+ Method name:  Turnaround_start()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine starts the reply turnaround time on TCB1. Called from the
+		 receive ISR when a request has been received, a reply will not be sent
+		 before the timer has elapsed.
+
+ Resources:	TCB1
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+void Turnaround_start(uint16_t ticks) {
+	turnaroundDone = FALSE;
+	TCB1.CTRLA &= ~TCB_ENABLE_bm;
+	TCB1.CNT = 0;
+	TCB1.CCMP = ticks;
+	TCB1.INTFLAGS = TCB_CAPT_bm;		//clear a timeout that might be pending
+	TCB1.CTRLA |= TCB_ENABLE_bm;
+}
+
+/*
+ ========================================================================================
+ Method name:  Turnaround_elapsed()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine is called from the TCB1 interrupt when the turnaround time has
+		 elapsed. Stops the timer and sends the reply if one is armed.
+
+ Resources:	TCB1
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+void Turnaround_elapsed(void) {
+	TCB1.CTRLA &= ~TCB_ENABLE_bm;
+	turnaroundDone = TRUE;
+	if (txArmed) {
+		USART_StartTxPRIV();
+	}
+}
+
+/*
+ ========================================================================================
+ Method name:  FrameTimer_start()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine restarts TCB0 from 0 so it times out after the given number of
+		 FRAME_TIMER_CLOCK ticks. Called on every received character.
+
+ Resources:	TCB0
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+void FrameTimer_start(uint16_t ticks) {
+	TCB0.CTRLA &= ~TCB_ENABLE_bm;
+	TCB0.CNT = 0;
+	TCB0.CCMP = ticks;
+	TCB0.INTFLAGS = TCB_CAPT_bm;		//clear a timeout that might be pending
+	TCB0.CTRLA |= TCB_ENABLE_bm;
+}
+
+/*
+ ========================================================================================
+ Method name:  FrameTimer_reload()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine sets the next timeout of TCB0. Called from the TCB0 interrupt,
+		 the counter has just restarted from 0 on the compare match.
+
+ Resources:	TCB0
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+void FrameTimer_reload(uint16_t ticks) {
+	TCB0.CCMP = ticks;
 }
 
+/*
+ ========================================================================================
+ Method name:  FrameTimer_stop()
+
+ Originator:   
+
+ Description:
+ 	 	 This routine stops TCB0 once the bus is idle.
+
+ Resources:	TCB0
 
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+void FrameTimer_stop(void) {
+	TCB0.CTRLA &= ~TCB_ENABLE_bm;
+}
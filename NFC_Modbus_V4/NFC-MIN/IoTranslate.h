@@ -22,6 +22,16 @@ Other requirements:
 1.01	11-04-2019	Adapted from CPAM								Anish Venkataraman
 1.02	12-09-2019	Removed change of baud rate						Anish Venkataraman
 1.03	06-26-2020	Modified macro for I2C delay and UART init		Anish Venkataraman
+1.04	10-16-2026	UART receive buffer changed to SPSC ring buffer
+1.05	10-16-2026	Added TCB0 Modbus frame timer
+1.06	10-16-2026	UART transmit through ring buffer and DRE interrupt
+1.07	10-16-2026	minRxEnable()/minTxEnable() empty in RS485_XDIR_MODE
+1.08	10-16-2026	Reply turnaround from TCB1 instead of NOP delay
+1.09	10-16-2026	Removed UART receive ring buffer, characters are read
+					from the USART straight into the Modbus frame buffer
+1.10	10-16-2026	USART_RxChar() returns RX_OVERRUN and RX_FRAME_ERROR,
+					added minEnterCritical()/minExitCritical()
+1.11	10-16-2026	TX_BUFFER_LENGTH holds the largest reply
 ---------------------------------------------------------------------------------------
 */
 #ifndef IOTRANSLATE_H_
@@ -30,17 +40,34 @@ Other requirements:
 #include "usart.h"
 #include "atmel_start_pins.h"
 #include "Build.h"
+#include "atomic.h"
 
 //UART
-#define RX_BUFFER_LENGTH	255
+#define TX_BUFFER_LENGTH	256							// 8 bit head/tail, holds 255 characters: the largest reply
+#define TX_BUFFER_MASK		(TX_BUFFER_LENGTH - 1)
 #define ERR					 1
 #define NO_ERR				 0
+#define RX_OVERRUN			 2							// Character received, one or more before it were lost
+#define RX_FRAME_ERROR		 3							// Character received without stop bit
 uint8_t USART_RxChar(unsigned char *val);
 void USART_SendChar(unsigned char *str);
 uint8_t USART_GetCharsInRxBuf(void);
 void USART_ClearRxBuffer(void);
-void USART_StoreData(void);
 void USART_SetTxInterrupt(void);
+void USART_ServiceTx(void);
+uint8_t USART_TxBufEmpty(void);
+
+//Modbus frame timer (TCB0)
+#define FRAME_TIMER_CLOCK	(F_CPU / 2)					// TCB0 runs from CLK_PER/2, see tcb.c
+void FrameTimer_start(uint16_t ticks);
+void FrameTimer_reload(uint16_t ticks);
+void FrameTimer_stop(void);
+
+//Reply turnaround timer (TCB1)
+#define TURNAROUND_TICKS_PER_USEC	(FRAME_TIMER_CLOCK / 1000000UL)	// TCB1 runs from CLK_PER/2 as well
+void Turnaround_start(uint16_t ticks);
+void Turnaround_elapsed(void);
+void USART_EndTx(void);
 
 //GPIO
 #define HeartBeatLED_Blink()			LED_toggle_level()
@@ -75,10 +102,24 @@ void IoTranslate_SendBytes(uint16_t address, uint8_t * data, uint8_t length);
 #define HardwareUart_SendChar(x)		USART_SendChar(&x)
 #define HardwareUart_GetCharsInRxBuf() (uint8_t)USART_GetCharsInRxBuf()
 #define HardwareUart_clearRxBuf()		USART_ClearRxBuffer()
+#if RS485_XDIR_MODE
+#define minRxEnable()					// USART drives XDIR, see Build.h
+#define minTxEnable()
+#else
 #define minRxEnable()					Tx_Enable_set_level(FALSE)
 #define minTxEnable()					Tx_Enable_set_level(TRUE)
-#define MinTurnAroundDelayMAC()			Hardware_Delay(TWO_MSEC)
+#endif
+#define MinTurnAroundStart(x)			Turnaround_start(x)
 #define Enable_TXInterrupt()			USART_SetTxInterrupt()
+#define HardwareUart_TxDone()			USART_TxBufEmpty()
+#define HardwareUart_EndTx()			USART_EndTx()
+#define minFrameTimerStart(x)			FrameTimer_start(x)
+#define minFrameTimerReload(x)			FrameTimer_reload(x)
+#define minFrameTimerStop()				FrameTimer_stop()
+
+//Interrupts, the critical section keeps data shared with an ISR consistent
+#define minEnterCritical()				ENTER_CRITICAL(R)
+#define minExitCritical()				EXIT_CRITICAL(R)
 
 //ISR
 void DriverISR_clearParseFLF(void);
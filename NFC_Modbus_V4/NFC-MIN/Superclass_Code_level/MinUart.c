@@ -16,6 +16,26 @@ Description:
 *-------*-----------*---------------------------------------------------*--------------
 1.00	07-10-2019  New file											Tom Van Sistine
 1.01	12-09-2019	Removed change of baud rate module	 			   Anish Venkataraman
+1.02	10-16-2026	MinUart_serviceRx() 1.02
+1.03	10-16-2026	MinUart_init() 1.02, MinUart_serviceRx() 1.03,
+					MinUart_serviceFrameTimer() 1.00
+1.04	10-16-2026	MinUart_serviceTx() 1.01
+1.05	10-16-2026	MinUart_init() 1.03, MinUart_serviceRx() 1.04,
+					MinUart_setTurnaround() 1.00
+1.06	10-16-2026	MinUart_serviceRx() 1.05, get_crc_16() 1.01,
+					update_crc_16() 1.00
+1.07	10-16-2026	MinUart_serviceRx() 1.06
+1.08	10-16-2026	MinUart_init() 1.04, MinUart_serviceRx() 1.07,
+					MinUart_getFrame() 1.00, MinUart_releaseFrame() 1.00
+1.09	10-16-2026	MinUart_serviceRx() 1.08
+1.10	10-16-2026	MinUart_serviceRx() 1.09, MinUart_getFrame() 1.01,
+					MinUart_releaseFrame() 1.01
+1.11	10-16-2026	MinUart_serviceRx() 1.10, MinUart_serviceFrameTimer() 1.01,
+					MinUart_getFrame() 1.02, added MinUart_endOfFramePRIV()
+1.12	10-16-2026	MinUart_serviceRx() 1.11, MinUart_endOfFramePRIV() 1.01,
+					added MinUart_copyCounters() and MinUart_clearCounters()
+1.13	10-16-2026	MinUart_serviceRx() 1.12, MinUart_serviceFrameTimer() 1.02,
+					CRC errors counted for messages to any address
 ---------------------------------------------------------------------------------------
 */
 
@@ -24,6 +44,8 @@ Description:
 
 //lint -e9029	suppress "Mismatched essential type" PC-Lint 9.00k  Bug in PC-Lint does not like subscripts!
 
+static void MinUart_endOfFramePRIV(MinUart_STYP *uart);
+
 /*
 =======================================================================================
 Method name:    MinUart_init()
@@ -32,6 +54,9 @@ Originator:   	Tom Van Sistine
 
 Description:
 	Initializes the MIN driver.
+	Character time for the t1.5/t3.5 frame timer is set from baudSelect.
+	Reply turnaround is set back to default t3.5.
+	All frame slots are freed.
 
   
 =======================================================================================
@@ -39,14 +64,43 @@ Description:
 *-------*-----------*---------------------------------------------------*--------------
 1.00	07-18-2012	Initial Write										Tom Van Sistine
 1.01	12-09-2019	Removed change of baud rate module	 			   Anish Venkataraman
+1.02	10-16-2026	Set character time for frame timer
+1.03	10-16-2026	Set default reply turnaround
+1.04	10-16-2026	Free frame slots
 ---------------------------------------------------------------------------------------
 */
 void MinUart_init(MinUart_STYP *uart) {
-	uart->processPacketFlag = FALSE;
+	uint8_t i;
+
+	for (i = 0; i < MODBUS_FRAME_SLOTS; i++) {
+		uart->frame[i].state = MODBUS_FRAME_FREE;
+	}
+	uart->rxSlot = 0;
+	uart->processSlot = 0;
 	uart->currentState = (uint8_t)   WAIT_FOR_RESYNC;
 	uart->rxBufferIndex = 0U;
 	uart->badCrcFlag = 0U;
 	uart->dataLength = 10;
+	uart->frameGap = MODBUS_GAP_T35;	// Bus is idle, next character starts a message
+
+	switch (uart->baudSelect) {
+	case BR_SELECT_19200:
+		uart->charTicks = MODBUS_CHAR_TICKS(19200UL);
+		break;
+
+	case BR_SELECT_38400:
+		uart->charTicks = MODBUS_CHAR_TICKS(38400UL);
+		break;
+
+	case BR_SELECT_57600:
+		uart->charTicks = MODBUS_CHAR_TICKS(57600UL);
+		break;
+
+	default:
+		uart->charTicks = MODBUS_CHAR_TICKS(115200UL);
+		break;
+	}
+	MinUart_setTurnaround(uart, 0);
 
 	// Reinitialize the hardware UART
 	HardwareUart_Init();  
@@ -59,14 +113,14 @@ Method name:    MinUart_serviceRx()
                     
 Originator:   	Tom Van Sistine
 
-Description: 	Called by MinSlave_manageMessages() when byte received from MIN master.
+Description: 	Called by MinSlave_serviceRx() when byte received from MIN master.
 				THEREFORE: This is called from an interrupt and must be kept short and
 				efficient.
 
 				Handles parsing the message.
 
-				When the message is parsed and the CRC is correct it will set
-				processPacketFlag to let MinSlave know to respond.
+				When the message is parsed and the CRC is correct it will set the
+				frame slot to MODBUS_FRAME_READY to let MinSlave know to respond.
 
 				MIN support Modbus RTU Slave communications.
 
@@ -84,10 +138,34 @@ Description: 	Called by MinSlave_manageMessages() when byte received from MIN ma
 				Description section for brief description or the above mentioned document
 				for details).
 
+				Which function codes are accepted, if they are accepted as broadcast and
+				their request length come from the function code descriptor table
+				(pFunctionTable) so there is no function code switch here.
+
 				Synchronization is supposed to be minimum of 3.5
 				characters worth of time without character sent between requests. This
-				uses a count down timer reloaded when a character is received and
-				decremented in Events.c 1msec timer interrupt.
+				uses the TCB0 frame timer restarted when a character is received,
+				MinUart_serviceFrameTimer() sets frameGap when t1.5 and t3.5 elapse.
+				More than t1.5 of silence inside a message breaks the message.
+
+				Characters are read from the USART straight into frame slot rxSlot,
+				there is no other receive buffer. The slots are used in turn so
+				MinSlave takes the messages in the order received. A slot still held
+				by an NFC write is skipped. If no slot is free (the messages have not
+				been handled yet) a new message is ignored rather than overwriting one.
+
+				A request to this slave with a function code that is not in the
+				descriptor table, or with a length byte out of range, can not be
+				framed from its descriptor. It is received up to the t1.5 gap instead
+				and, if the CRC is good, handed to MinSlave with an exception code to
+				reply with (see MinUart_serviceFrameTimer()).
+
+				Bus counters (uartCounterNumbers) are counted here: each message
+				started on the bus and each USART overrun or framing error. A
+				message for another slave is not stored, it is followed in state
+				CHECK_OTHER_SLAVE only for its CRC, checked at the t1.5 gap by
+				MinUart_serviceFrameTimer(), so CRC errors are counted for the whole
+				bus.
 
 
 =======================================================================================
@@ -95,6 +173,20 @@ Description: 	Called by MinSlave_manageMessages() when byte received from MIN ma
 *-------*-----------*---------------------------------------------------*--------------
 1.00	07-18-2012	Initial Write										Tom Van Sistine
 1.01	12-09-2019	Removed change of baud rate module	 			   Anish Venkataraman
+1.02	10-16-2026	Ignore new message until previous one is handled
+1.03	10-16-2026	Resync on t3.5 from frame timer instead of 1msec
+					count down, t1.5 inside message breaks message
+1.04	10-16-2026	Start reply turnaround timer when message is good
+1.05	10-16-2026	CRC updated as each byte is received
+1.06	10-16-2026	Character read straight from USART, FC16 longer than
+					a full frame is dropped
+1.07	10-16-2026	Receive into frame slots used in turn
+1.08	10-16-2026	Request length from function code descriptor table
+1.09	10-16-2026	Skip slot still held by NFC write
+1.10	10-16-2026	Unknown function code and bad length byte are framed
+					by t1.5 gap for exception reply
+1.11	10-16-2026	Count bus messages, overrun and framing errors
+1.12	10-16-2026	CRC of messages for other slaves checked
 ---------------------------------------------------------------------------------------
 */
 
@@ -102,11 +194,16 @@ void MinUart_serviceRx(MinUart_STYP *uart) {
 
 static uint8_t rxByte = 0;			// Because a pointer is passed with HardwareUart_RecvChar() should not be auto-variable.
 uint8_t error = 0;
-uint16_t crc;
 	// Get character from buffer
 	error = HardwareUart_RecvChar(rxByte);
 	
 	if (error) {
+		if (error == RX_OVERRUN) {
+			uart->counters[MIN_UART_OVERRUN_CNUM]++;
+		}
+		else if (error == RX_FRAME_ERROR) {
+			uart->counters[MIN_UART_FRAMING_ERROR_CNUM]++;
+		}
 		uart->currentState = WAIT_FOR_RESYNC;	// If in the middle of a message, this will wait until the end.
 		HardwareUart_clearRxBuf();
 		// Reset stuff needed in next character received is start of new message.
@@ -116,20 +213,34 @@ uint16_t crc;
 		return;
 	}
 
-	// NOTE: modbusReSync is decremented every 1msec in a timer interrupt.
-	// Check if modbusReSync is counter is 0 which indicates start of new message.  If between
-	// messages, it stays in WAIT_FOR_RESYNC state until modbusReSync counter is 0.
-	// If modbusReSync is 0, then, regardless of state, force it to state HANDLE_DEVICE_ID to re-
+	// NOTE: frameGap is set by the frame timer interrupt, see MinUart_serviceFrameTimer().
+	// Check if frameGap is MODBUS_GAP_T35 which indicates start of new message.  If between
+	// messages, it stays in WAIT_FOR_RESYNC state until t3.5 of silence.
+	// If frameGap is MODBUS_GAP_T35, then, regardless of state, force it to state PARSE_INCOMING to re-
 	// synchronize communication.
 
-    if (uart->modbusReSync == 0) {
+    if (uart->frameGap == MODBUS_GAP_T35) {
         uart->currentState = PARSE_INCOMING;
+		uart->counters[MIN_UART_BUS_MESSAGE_CNUM]++;
 		uart->badCrcFlag = 0;
 		uart->rxBufferIndex = 0;
 		uart->dataLength = 10;
+		uart->rxCrc = 0xFFFF;
+		if (uart->frame[uart->rxSlot].state >= MODBUS_FRAME_READY) {
+			uart->rxSlot = (uint8_t)((uart->rxSlot + 1) % MODBUS_FRAME_SLOTS);	// Slot still held by NFC write, try the other one
+		}
+		if (uart->frame[uart->rxSlot].state >= MODBUS_FRAME_READY) {
+			uart->currentState = WAIT_FOR_RESYNC;	// No free slot, message in it not handled yet, drop this one.
+		}
+		else {
+			uart->frame[uart->rxSlot].state = MODBUS_FRAME_RECEIVING;
+		}
+    }
+    else if (uart->frameGap == MODBUS_GAP_T15) {
+		uart->currentState = WAIT_FOR_RESYNC;	// More than t1.5 between characters, discard message.
     }
-    uart->modbusReSync = MODBUS_RESYNC_LOAD;	// Set for three 1msec interrupts that are asynchronous to MIN_OnRxChar()
-    											// to insure a minimum of 2 msec without receiving byte to indicate resync.
+    uart->frameGap = MODBUS_GAP_NONE;
+    minFrameTimerStart(MODBUS_T15_TICKS(uart->charTicks));	// Restart t1.5 time out from this character
 
 	// Run the UART character receive method state machine which parses the various types
 	// of messages from the Master device
@@ -137,11 +248,10 @@ uint16_t crc;
 
 	case WAIT_FOR_RESYNC:
 
-		// Waiting for resync, i.e. no characters for 2 msec.
+		// Waiting for resync, i.e. no characters for t3.5.
 		uart->badCrcFlag = 0;
 		uart->rxBufferIndex = 0;
 		uart->dataLength = 10;
-		USART_ClearRxBuffer();
 		break;
 
 	case PARSE_INCOMING:
@@ -149,98 +259,120 @@ uint16_t crc;
 		// Resync timeout elapsed
 
 		// Save received byte
-		uart->rxBuffer[uart->rxBufferIndex] = rxByte;
+		uart->frame[uart->rxSlot].data[uart->rxBufferIndex] = rxByte;
+		uart->rxCrc = update_crc_16(uart->rxCrc, rxByte);
 		
 		// Check if slave address matches this slave device
 		if (uart->rxBufferIndex == 0) {
 			if((rxByte != uart->moduleAddress) && rxByte != (uint8_t) MIN_MASTER_BROADCAST) {
-				uart->currentState = WAIT_FOR_RESYNC;  // Message not for this slave.
+				uart->currentState = CHECK_OTHER_SLAVE;  // Message not for this slave, CRC still counted.
 			}
 		}
 		
-		// Check if FC code then set expected number of bytes
+		// Check if FC code then set expected number of bytes from its descriptor
 		else if (uart->rxBufferIndex == (uint8_t) MIN_FUNCTION_CODE_INDEX) {
 			uart->functionCode = rxByte;
-			switch (uart->functionCode) {
-
-			case MIN_FC03:
-				uart->dataLength = NUMBER_REQUEST_BYTES_FC03;
-				break;
-
-			case MIN_FC06:
-				uart->dataLength = NUMBER_REQUEST_BYTES_FC06;
-				break;
-
-			case MIN_FC16:
-				uart->dataLength = NUMBER_REQUEST_BYTES_FC16;
-				break;
-
-			case MIN_FC65_SLAVE_POLL:
-				uart->dataLength = NUMBER_REQUEST_BYTES_FC65;
-				break;
-
-			case MIN_FC67_DISCOVER:
-				uart->dataLength = NUMBER_REQUEST_BYTES_FC67;
-				break;
-			
-			case MIN_FC69_GET_PRODUCT_INFO:
-				uart->dataLength = NUMBER_REQUEST_BYTES_FC69;
-				break;
-				
-			case MIN_FC70_STORE_PRODUCT_INFO:
-				uart->dataLength = NUMBER_REQUEST_BYTES_FC70;
-				break;
-
-			default: // Unknown FC code
-				uart->currentState = WAIT_FOR_RESYNC;
-				HardwareUart_clearRxBuf();
-				break;
+			uart->pFunction = 0;
+			if ((uart->pFunctionTable != 0) && (rxByte < MODBUS_FUNCTION_CODES)) {
+				uart->pFunction = &uart->pFunctionTable[rxByte];
+			}
+			uart->frame[uart->rxSlot].exceptionCode = 0;
+			if (uart->frame[uart->rxSlot].data[MIN_SLAVE_ADDRESS_INDEX] == (uint8_t) MIN_MASTER_BROADCAST) {
+				if ((uart->pFunction == 0) || (uart->pFunction->handler == 0) || (uart->pFunction->broadcastOK == FALSE)) {
+					uart->currentState = WAIT_FOR_RESYNC;	// FC code not allowed as broadcast, no reply to broadcast
+				}
+			}
+			else if ((uart->pFunction == 0) || (uart->pFunction->handler == 0)) {
+				// Unknown FC code, receive up to t1.5 gap and reply with exception
+				uart->frame[uart->rxSlot].exceptionCode = MODBUS_EXCEPTION_ILLEGAL_FUNCTION;
+				uart->pFunction = 0;
+				uart->dataLength = RX_BLOCK_BUFFER_SIZE;
+			}
+			if ((uart->currentState == PARSE_INCOMING) && (uart->pFunction != 0)) {
+				uart->dataLength = uart->pFunction->minLength;
 			}
 		}
 
-		// FC16 received and number of data bytes is rxByte?
-		if ((uart->functionCode == (uint8_t) MIN_FC16) && (uart->rxBufferIndex == (uint8_t) MIN_FC16_BYTES_TO_RX_INDEX)) {
-			
-			uart->dataLength = rxByte + 9;
+		// Variable length request and number of bytes is rxByte?
+		else if ((uart->pFunction != 0) && (uart->rxBufferIndex == uart->pFunction->lengthIndex)) {
+			uart->dataLength = (uint16_t) rxByte + uart->pFunction->lengthAdd;
+			if ((uart->dataLength < uart->pFunction->minLength) || (uart->dataLength > uart->pFunction->maxLength)) {
+				if (uart->frame[uart->rxSlot].data[MIN_SLAVE_ADDRESS_INDEX] == (uint8_t) MIN_MASTER_BROADCAST) {
+					uart->currentState = WAIT_FOR_RESYNC;	// Would not fit in a Modbus frame
+				}
+				else {
+					// Receive up to t1.5 gap and reply with exception
+					uart->frame[uart->rxSlot].exceptionCode = MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE;
+					uart->pFunction = 0;
+					uart->dataLength = RX_BLOCK_BUFFER_SIZE;
+				}
+			}
 		}
-		// FC70 received and number of data bytes is rxByte?
-		else if((uart->functionCode == (uint8_t) MIN_FC70_STORE_PRODUCT_INFO) && (uart->rxBufferIndex == (uint8_t) MIN_FC70_BYTES_TO_RX_INDEX)){
-			uart->dataLength = rxByte;
-		}	
 		// Increment buffer pointer
 		
 		uart->rxBufferIndex += 1;
 		
 		// Have all bytes arrived?
 
-		if (uart->rxBufferIndex >= uart->dataLength) {
+		if ((uart->currentState == PARSE_INCOMING) && (uart->rxBufferIndex >= uart->dataLength)) {
             // All bytes received
-
-			// Reset state for next incoming message regardless of CRC check.
-			uart->currentState = WAIT_FOR_RESYNC;   // In case extra bytes sent
-			uart->rxBufferIndex = 0;				// Make sure next received character is assumed to be first.
-
-			// Check CRC, if good signal calling method to process it and reply.
-			crc = get_crc_16(0xFFFF, uart->rxBuffer, (uart->dataLength - 2));
-			
-			if (crc == (((uint16_t) uart->rxBuffer[uart->dataLength - 1] << 8) +  (uint16_t) uart->rxBuffer[uart->dataLength - 2])) {
-				
-		        // CRC is good!
-		    	// Set flag to process message upon return to MinSlave_manageMessage()
-				uart->badCrcFlag = FALSE;
-		    	uart->processPacketFlag = TRUE;
-			}
-			else {
-				uart->badCrcFlag = TRUE;
-				uart->processPacketFlag = FALSE;
-			}
+			MinUart_endOfFramePRIV(uart);
 		}
+		break;
+
+	case CHECK_OTHER_SLAVE:
+
+		// Message for another slave ends at the t1.5 gap, see MinUart_serviceFrameTimer()
+		uart->rxCrc = update_crc_16(uart->rxCrc, rxByte);
+		break;
 
 	} // End switch current state
 
 
 }
 
+/*
+================================================================================================
+Method name:    MinUart_endOfFramePRIV()
+                    
+Originator:   	
+
+Description:  	Called when all bytes of a message are received. CRC is run over all
+				bytes including CRCL and CRCH so it is 0 when good. A good message is
+				handed to MinSlave_manageMessages() and the reply turnaround timer is
+				started, otherwise the slot is freed and the CRC error counted.
+
+  
+=======================================================================================
+ History: (Identify changes in this method)	
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Broke out of MinUart_serviceRx()
+1.01	10-16-2026	Count CRC errors
+---------------------------------------------------------------------------------------
+*/
+
+static void MinUart_endOfFramePRIV(MinUart_STYP *uart){
+
+	// Reset state for next incoming message regardless of CRC check.
+	uart->currentState = WAIT_FOR_RESYNC;   // In case extra bytes sent
+	uart->rxBufferIndex = 0;				// Make sure next received character is assumed to be first.
+
+	if (uart->rxCrc == 0) {
+		
+		// CRC is good!
+		// Hand slot to MinSlave_manageMessages() and receive next message into the other slot
+		uart->badCrcFlag = FALSE;
+		uart->frame[uart->rxSlot].state = MODBUS_FRAME_READY;
+		uart->rxSlot = (uint8_t)((uart->rxSlot + 1) % MODBUS_FRAME_SLOTS);
+		MinTurnAroundStart(uart->turnaroundTicks);	// Reply is held until the master had time to release the bus
+	}
+	else {
+		uart->badCrcFlag = TRUE;
+		uart->counters[MIN_UART_CRC_ERROR_CNUM]++;
+		uart->frame[uart->rxSlot].state = MODBUS_FRAME_FREE;
+	}
+}
+
 /*--------------------------------------------------------------------------------------------
 Name:           get_crc_16()
 
@@ -274,37 +406,83 @@ Date        Programmer        Rev     Description
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    07-11-2019  Original code                                       Tom Van Sistine
+ 1.01    10-16-2026  Byte wise using 256 entry table in flash
 
  ----------------------------------------------------------------------------------------
  */
-uint16_t crc_16_table[16] = {0x0000, 0xCC01, 0xD801, 0x1400, 0xF001, 0x3C00, 0x2800, 0xE401,
-  0xA001, 0x6C00, 0x7800, 0xB401, 0x5000, 0x9C01, 0x8801, 0x4400 };
+// Byte wise CRC-16 (Modbus, polynomial 0xA001 reflected) table, kept in flash.
+const __flash uint16_t crc_16_table[256] = {
+	0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+	0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+	0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+	0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+	0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+	0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+	0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+	0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+	0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+	0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+	0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+	0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+	0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+	0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+	0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+	0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+	0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+	0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+	0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+	0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+	0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+	0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+	0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+	0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+	0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+	0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+	0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+	0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+	0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+	0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+	0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+	0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
 
 uint16_t get_crc_16 (uint16_t start, uint8_t *p, uint16_t n) {
 uint16_t crc = start;
-uint16_t r;
 
   /* while there is more data to process */
   while (n-- > 0) {
+    crc = update_crc_16(crc, *p++);
+  }
 
-    /* compute checksum of lower four bits of *p */
-    r = crc_16_table[crc & 0xF];
-    crc = (crc >> 4) & 0x0FFF;
-    crc = crc ^ r ^ crc_16_table[*p & 0xF];
+  return(crc);
+}
 
-    /* now compute checksum of upper four bits of *p */
-    r = crc_16_table[crc & 0xF];
-    crc = (crc >> 4) & 0x0FFF;
-    crc = crc ^ r ^ crc_16_table[(*p >> 4) & 0xF];
+/*
+ ========================================================================================
+ Method name:  	update_crc_16()
 
-    /* next... */
-    p++;
-  }
+ Originator:    
 
-  return(crc);
+ Description:   Adds one byte to a running CRC-16. Returns the new CRC value.
+				Start with 0xFFFF. Running the CRC over a whole message including
+				its CRCL and CRCH bytes gives 0 when the CRC is good.
+
+ Resources:		crc_16_table[] in flash
+
+ ========================================================================================
+ History:
+ *-------*-----------*---------------------------------------------------*---------------
+ 1.00    10-16-2026  Original code
+
+ ----------------------------------------------------------------------------------------
+ */
+uint16_t update_crc_16 (uint16_t crc, uint8_t data) {
+
+  return (uint16_t)((crc >> 8) ^ crc_16_table[(uint8_t)(crc ^ data)]);
 }
 
 
+
 /*
 ================================================================================================
 Method name:    MinUart_serviceTx()
@@ -312,20 +490,222 @@ Method name:    MinUart_serviceTx()
 Originator:   	Tom Van Sistine
 
 Description:  	Services the onTxComplete after MIN reply to command or poll is sent out.
-				Turns off RS-485 driver, clears Rx buffer and turns on UART receive.
+				Turns off RS-485 driver so the transceiver is back to receive.
+				The UART and the parser are left as they are.
 
   
 =======================================================================================
  History: (Identify changes in this method)	
 *-------*-----------*---------------------------------------------------*--------------
 1.00	07-10-2019	Initial Write										Tom Van Sistine
+1.01	10-16-2026	Removed MinUart_init(), UART no longer reinitialized
 ---------------------------------------------------------------------------------------
 */
 
 void MinUart_serviceTx(MinUart_STYP *uart){
 	// If the last byte has been transmitted then change the 485 to receive
-	MinUart_init(uart);  // Reset everything.
+	(void) uart;
 	minRxEnable();
 }
 
+/*
+================================================================================================
+Method name:    MinUart_serviceFrameTimer()
+                    
+Originator:   	
+
+Description:  	Called from the TCB0 frame timer interrupt. The timer is restarted by
+				MinUart_serviceRx() on each character with the t1.5 time out. When it
+				times out frameGap is set to MODBUS_GAP_T15 and the timer is reloaded for
+				the remaining time to t3.5. When that times out frameGap is set to
+				MODBUS_GAP_T35 and the timer is stopped until the next character.
+				A message that is framed by the gap (pFunction is 0, see
+				MinUart_serviceRx()) ends at t1.5, as does a message for another
+				slave, which only has its CRC error counted.
+
+  
+=======================================================================================
+ History: (Identify changes in this method)	
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+1.01	10-16-2026	End of message framed by gap
+1.02	10-16-2026	Count CRC error of a message for another slave
+---------------------------------------------------------------------------------------
+*/
 
+void MinUart_serviceFrameTimer(MinUart_STYP *uart){
+	if (uart->frameGap == MODBUS_GAP_NONE) {
+		if (uart->currentState == CHECK_OTHER_SLAVE) {
+			if (uart->rxCrc != 0) {
+				uart->counters[MIN_UART_CRC_ERROR_CNUM]++;
+			}
+			uart->currentState = WAIT_FOR_RESYNC;
+		}
+		if ((uart->currentState == PARSE_INCOMING) && (uart->pFunction == 0) &&
+			(uart->rxBufferIndex > MIN_FUNCTION_CODE_INDEX)) {
+			MinUart_endOfFramePRIV(uart);
+		}
+		uart->frameGap = MODBUS_GAP_T15;
+		minFrameTimerReload(MODBUS_T35_TICKS(uart->charTicks));
+	}
+	else {
+		uart->frameGap = MODBUS_GAP_T35;
+		minFrameTimerStop();
+	}
+}
+
+/*
+================================================================================================
+Method name:    MinUart_setTurnaround()
+                    
+Originator:   	
+
+Description:  	Sets the time from the end of a request to the start of the reply.
+				usec is in microseconds, 0 selects the default of t3.5 at the selected
+				baud rate. Values above MODBUS_TURNAROUND_MAX_USEC are limited to it.
+
+  
+=======================================================================================
+ History: (Identify changes in this method)	
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+---------------------------------------------------------------------------------------
+*/
+
+void MinUart_setTurnaround(MinUart_STYP *uart, uint16_t usec){
+	if (usec == 0) {
+		uart->turnaroundTicks = MODBUS_TURNAROUND_DEFAULT_TICKS(uart->charTicks);
+	}
+	else {
+		if (usec > MODBUS_TURNAROUND_MAX_USEC) {
+			usec = MODBUS_TURNAROUND_MAX_USEC;
+		}
+		uart->turnaroundTicks = (uint16_t)(usec * TURNAROUND_TICKS_PER_USEC);
+	}
+}
+
+/*
+================================================================================================
+Method name:    MinUart_getFrame()
+                    
+Originator:   	
+
+Description:  	Called from the main loop. If the next frame slot in turn holds a complete
+				message it is marked MODBUS_FRAME_BUSY and a pointer to the message is
+				returned, otherwise 0. exceptionCode is set to the Modbus exception to
+				reply with instead of handling the message, 0 if none. The slot stays BUSY, and is not received into,
+				until MinUart_releaseFrame().
+				A slot kept BUSY for an NFC write is skipped by the receive ISR, so the
+				next message may be in the slot after the one in turn.
+
+  
+=======================================================================================
+ History: (Identify changes in this method)	
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+1.01	10-16-2026	Look for the message in all slots, starting at the one in turn
+1.02	10-16-2026	Return exception code set while receiving
+---------------------------------------------------------------------------------------
+*/
+
+uint8_t *MinUart_getFrame(MinUart_STYP *uart, uint8_t *exceptionCode){
+	MinFrame_STYP *frame;
+	uint8_t i;
+	uint8_t slot = uart->processSlot;
+
+	for (i = 0; i < MODBUS_FRAME_SLOTS; i++) {
+		frame = &uart->frame[slot];
+		if (frame->state == MODBUS_FRAME_READY) {
+			frame->state = MODBUS_FRAME_BUSY;
+			uart->processSlot = (uint8_t)((slot + 1) % MODBUS_FRAME_SLOTS);
+			*exceptionCode = frame->exceptionCode;
+			return frame->data;
+		}
+		slot = (uint8_t)((slot + 1) % MODBUS_FRAME_SLOTS);
+	}
+	return 0;
+}
+
+/*
+================================================================================================
+Method name:    MinUart_releaseFrame()
+                    
+Originator:   	
+
+Description:  	Frees the frame slot holding message data (the pointer returned by
+				MinUart_getFrame()) so the receive ISR can use it again. Slots can be
+				released out of turn, a slot handed to an NFC write is released after
+				the write while later messages are handled.
+
+  
+=======================================================================================
+ History: (Identify changes in this method)	
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+1.01	10-16-2026	Release the slot of the message passed in
+---------------------------------------------------------------------------------------
+*/
+
+void MinUart_releaseFrame(MinUart_STYP *uart, uint8_t *data){
+	uint8_t i;
+
+	for (i = 0; i < MODBUS_FRAME_SLOTS; i++) {
+		if ((uart->frame[i].data == data) && (uart->frame[i].state == MODBUS_FRAME_BUSY)) {
+			uart->frame[i].state = MODBUS_FRAME_FREE;
+		}
+	}
+}
+
+/*
+================================================================================================
+Method name:    MinUart_copyCounters()
+                    
+Originator:   	
+
+Description:  	Copies the bus counters (MIN_UART_NUMBER_OF_COUNTERS words) to pDest.
+				The receive ISR counts them, interrupts are held off while copying so
+				no count is read half updated.
+
+  
+=======================================================================================
+ History: (Identify changes in this method)	
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+---------------------------------------------------------------------------------------
+*/
+
+void MinUart_copyCounters(MinUart_STYP *uart, uint16_t *pDest){
+	uint8_t i;
+
+	minEnterCritical();
+	for (i = 0; i < MIN_UART_NUMBER_OF_COUNTERS; i++) {
+		pDest[i] = uart->counters[i];
+	}
+	minExitCritical();
+}
+
+/*
+================================================================================================
+Method name:    MinUart_clearCounters()
+                    
+Originator:   	
+
+Description:  	Sets the bus counters back to 0.
+
+  
+=======================================================================================
+ History: (Identify changes in this method)	
+*-------*-----------*---------------------------------------------------*--------------
+1.00	10-16-2026	Initial Write
+---------------------------------------------------------------------------------------
+*/
+
+void MinUart_clearCounters(MinUart_STYP *uart){
+	uint8_t i;
+
+	minEnterCritical();
+	for (i = 0; i < MIN_UART_NUMBER_OF_COUNTERS; i++) {
+		uart->counters[i] = 0;
+	}
+	minExitCritical();
+}
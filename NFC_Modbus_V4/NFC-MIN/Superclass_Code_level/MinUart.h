@@ -14,22 +14,43 @@ Multi-Instance: No
 
 Class Methods:
 	MinUart_Init();					Called from MinSlave_init()
-	MinUart_ServiceRx();			Called directly through MinSlave from OnRxChar()
-								    in Events.c when a char is received.
+	MinUart_ServiceRx();			Called through MinSlave_serviceRx() from the USART
+								    receive ISR in driver_isr.c when a char is received.
 	MinUart_ServiceTx(); 			Called from OnTxComplete() in Events.c whenever
 	                                the transmission packet is finished being sent out.
+	MinUart_serviceFrameTimer();	Called from the TCB0 interrupt in driver_isr.c when
+									t1.5 and then t3.5 of silence has elapsed.
+	MinUart_getFrame();				Called from MinSlave_manageMessages() to take the
+									oldest received message.
+	MinUart_releaseFrame();			Called from MinSlave_manageMessages(), or through
+									MinSlave_releaseFrame() after an NFC write, when
+									the message taken is done with.
+
+	Request framing comes from the function code descriptor table (MinFunction_STYP)
+	owned by MinSlave, pFunctionTable is set by MinSlave_init() before MinUart_init().
+
+	Messages are received into two frame slots used in turn. Each slot goes
+	FREE -> RECEIVING -> READY (good CRC) -> BUSY (taken by MinSlave) -> FREE, so
+	the next request can be received while the previous one is still processed.
+	A slot handed to an NFC write stays BUSY until the write is done, the other
+	slot keeps receiving so requests can still be answered in the meantime.
 
 Peripheral Resources:
 	Assume as UART is available for 19,200 up to 115,200 baud
 
 IoTranslate requirements:
-	HardwareUart_RecvChar()         // Fetch 1 character from Uart buffer
+	HardwareUart_RecvChar()         // Fetch 1 character from the USART
 	minRxEnable()                   // Clears TxEnable digital output
-	minTxEnable()					// Sets TxEnable digital output
-	HardwareUart_ClearBuffer()      // Reset UART buffer read and write indexes and clears char in Rx flag and full flag
-	HardwareUart_SendChar()         // Sends one character out UART
-	HardwareUart_GetCharsInRxBuf()  // Checks for characters in buffer.
-	Enable_TXInterrupt()			//Enables Transmission interrupt
+	minTxEnable()					// Sets TxEnable digital output (IoTranslate, when turnaround elapsed)
+	HardwareUart_clearRxBuf()       // Discards characters in the USART receive FIFO
+	HardwareUart_SendChar()         // Queues one character to send out UART
+	HardwareUart_TxDone()           // Checks transmit buffer is empty
+	HardwareUart_GetCharsInRxBuf()  // Checks for a received character.
+	Enable_TXInterrupt()			//Starts sending queued characters
+	minFrameTimerStart()			// Restarts frame timer to time out after x ticks
+	minFrameTimerReload()			// Sets next frame timer time out from frame timer ISR
+	minFrameTimerStop()				// Stops frame timer
+	MinTurnAroundStart()			// Starts reply turnaround timer, reply is held until it elapses
 Other requirements:
 
 
@@ -41,6 +62,30 @@ Other requirements:
 1.01	08-01-2019  Add FC65 slave poll and FC66 baud rate enums.		Tom Van Sistine
 1.02	08-12-2020  Updated productinfo bytes to receive length.   	 Anish Venkataraman
 1.03	08-28-2020	Updated NUMBER_REQUEST_BYTES_FC70 enum			 Anish Venkataraman
+1.04	10-16-2026	processPacketFlag is volatile, set in ISR and
+					cleared from main loop
+1.05	10-16-2026	modbusReSync 1msec count down replaced by frameGap
+					set from t1.5/t3.5 frame timer
+1.06	10-16-2026	Added turnaroundTicks and MinUart_setTurnaround()
+1.07	10-16-2026	Added rxCrc and update_crc_16()
+1.08	10-16-2026	rxBuffer is the only receive frame buffer, sized for
+					a full 256 byte Modbus RTU frame
+1.09	10-16-2026	rxBuffer and processPacketFlag replaced by two frame
+					slots, added MinUart_getFrame() and MinUart_releaseFrame()
+1.10	10-16-2026	Added MinFunction_STYP function code descriptor,
+					request lengths come from descriptor table
+1.11	10-16-2026	MinUart_releaseFrame() releases the slot of the message
+					passed in, added Modbus exception codes
+1.12	10-16-2026	Added exceptionCode to MinFrame_STYP
+1.13	10-16-2026	Added FC04 and FC23 request constants, MODBUS_WORD()
+1.14	10-16-2026	Added FC43/14 Read Device Identification constants
+1.15	10-16-2026	Added bus counters, FC08/FC11/FC12 diagnostics and
+					comm event constants
+1.16	10-16-2026	Added FC22 Mask Write Register constants
+1.17	10-16-2026	Added FC24 Read FIFO Queue constants
+1.18	10-16-2026	MODBUS_T35_TICKS is 2 chars after t1.5, 3.5 chars of silence
+1.19	10-16-2026	Send event exception bits as the Modbus specification
+1.20	10-16-2026	Added CHECK_OTHER_SLAVE, CRC errors counted for any address
 ---------------------------------------------------------------------------------------
 */
 
@@ -55,6 +100,7 @@ Other requirements:
 enum {
 	WAIT_FOR_RESYNC,
 	PARSE_INCOMING,
+	CHECK_OTHER_SLAVE,		// Message for another slave, only its CRC is checked
 };
 
 // Use enum to define MIN constants
@@ -134,13 +180,128 @@ enum  {
 	MODBSU_FC70_BYTES_TO_RX_INDEX = 2,
 	MODBUS_FC70_DATA_START_INDEX = 3,
 	MODBUS_FC70_PAYLOAD = 5,
+	MODBUS_EXCEPTION_CODE_INDEX = 2,
+	MODBUS_EXCEPTION_REPLY_LENGTH = 3,
+	MODBUS_FC23_READ_START_INDEX = 3,
+	MODBUS_FC23_READ_NUM_REG_INDEX = 5,
+	MODBUS_FC23_WRITE_START_INDEX = 7,
+	MODBUS_FC23_WRITE_NUM_REG_INDEX = 9,
+	MODBUS_FC23_BYTES_TO_RX_INDEX = 10,
+	MODBUS_FC23_DATA_START_INDEX = 11,
+	MODBUS_FC43_MEI_TYPE_INDEX = 2,
+	MODBUS_FC43_READ_DEVICE_ID_CODE_INDEX = 3,
+	MODBUS_FC43_OBJECT_ID_INDEX = 4,
+	MODBUS_FC43_CONFORMITY_LEVEL_INDEX = 4,
+	MODBUS_FC43_MORE_FOLLOWS_INDEX = 5,
+	MODBUS_FC43_NEXT_OBJECT_ID_INDEX = 6,
+	MODBUS_FC43_NUMBER_OF_OBJECTS_INDEX = 7,
+	MODBUS_FC43_OBJECTS_START_INDEX = 8,
+	MODBUS_FC08_SUB_FUNCTION_INDEX = 3,
+	MODBUS_FC08_DATA_INDEX = 5,
+	MODBUS_FC08_REPLY_LENGTH = 6,
+	MODBUS_FC11_STATUS_INDEX = 3,
+	MODBUS_FC11_EVENT_COUNT_INDEX = 5,
+	MODBUS_FC11_REPLY_LENGTH = 6,
+	MODBUS_FC12_BYTES_REPLY_INDEX = 2,
+	MODBUS_FC12_STATUS_INDEX = 4,
+	MODBUS_FC12_EVENT_COUNT_INDEX = 6,
+	MODBUS_FC12_MESSAGE_COUNT_INDEX = 8,
+	MODBUS_FC12_EVENTS_START_INDEX = 9,
+	MODBUS_FC12_FIXED_BYTES = 6,
+	MODBUS_FC22_AND_MASK_INDEX = 5,
+	MODBUS_FC22_OR_MASK_INDEX = 7,
+	MODBUS_FC22_REPLY_LENGTH = 8,
+	MODBUS_FC24_FIFO_ADDR_INDEX = 3,
+	MODBUS_FC24_BYTE_COUNT_INDEX = 3,
+	MODBUS_FC24_FIFO_COUNT_INDEX = 5,
+	MODBUS_FC24_DATA_START_INDEX = 6,
+};
+
+// FC08 Diagnostics sub-functions
+enum {
+	MODBUS_DIAG_RETURN_QUERY_DATA = 0x00,
+	MODBUS_DIAG_CLEAR_COUNTERS = 0x0A,
+	MODBUS_DIAG_BUS_MESSAGE_COUNT,			// Messages seen on the bus, any address
+	MODBUS_DIAG_BUS_COMM_ERROR_COUNT,		// CRC and framing errors
+	MODBUS_DIAG_BUS_EXCEPTION_COUNT,		// Exception replies sent
+	MODBUS_DIAG_SLAVE_MESSAGE_COUNT,		// Requests to this slave handled, including broadcasts
+	MODBUS_DIAG_SLAVE_NO_RESPONSE_COUNT,	// Requests not replied to (broadcasts)
+	MODBUS_DIAG_SLAVE_NAK_COUNT,
+	MODBUS_DIAG_SLAVE_BUSY_COUNT,			// Exception 06 replies sent
+	MODBUS_DIAG_BUS_OVERRUN_COUNT,			// Characters lost, USART receive overrun
+};
+
+// FC11/FC12 comm status, FFFF while a previous request is still being processed
+#define MODBUS_COMM_STATUS_READY	0x0000U
+#define MODBUS_COMM_STATUS_BUSY		0xFFFFU
+
+// FC12 comm event log bytes. A receive event is logged for each request taken by MinSlave,
+// a send event for each reply.
+#define MODBUS_EVENT_RECEIVE			0x80U	// Receive event
+#define MODBUS_EVENT_RX_BROADCAST		0x40U	//  Broadcast received
+#define MODBUS_EVENT_RX_OVERRUN			0x10U	//  Character overrun since last receive event
+#define MODBUS_EVENT_RX_COMM_ERROR		0x02U	//  CRC or framing error since last receive event
+#define MODBUS_EVENT_SEND				0x40U	// Send event
+#define MODBUS_EVENT_SEND_READ_EXCEPTION 0x01U	//  Exception 01 to 03 sent
+#define MODBUS_EVENT_SEND_ABORT			0x02U	//  Exception 04 sent
+#define MODBUS_EVENT_SEND_BUSY			0x04U	//  Exception 05 or 06 sent
+
+// FC43 MEI type 14 Read Device Identification, ReadDevId codes
+#define MODBUS_MEI_READ_DEVICE_ID	0x0EU
+enum {
+	MODBUS_DEVICE_ID_BASIC = 1,		// Stream objects 0x00 to 0x02
+	MODBUS_DEVICE_ID_REGULAR,		// Stream objects up to 0x7F
+	MODBUS_DEVICE_ID_EXTENDED,		// Stream objects up to 0xFF
+	MODBUS_DEVICE_ID_INDIVIDUAL,	// One object
 };
 
+// 16 bit request field, index is of the low byte which follows the high byte
+#define MODBUS_WORD(frame, index)	((uint16_t)(((uint16_t)(frame)[(index) - 1] << 8) | (frame)[(index)]))
+
 // In Build.h #define MIN_SLAVE_ADDRESS for slave module.
-#define MIN_RECEIVE_BLOCK_SIZE (uint16_t) 128U // 128 registers is maximum block size
-#define RX_BLOCK_BUFFER_SIZE  ((MIN_RECEIVE_BLOCK_SIZE * MIN_BYTES_PER_REG) + 8U) // 8 = SlaveAddress, AddressH, AddressL, NumberRegH, NumberRegL, Byte count, CRCL, CRCH
-#define MODBUS_RESYNC_LOAD 3	// Msec interrupt counter.  Reset to this when byte received from MIN master.  Not sychronized with 1msec timer
-								// so set to 3 to insure minimum of 2 msec time.
+// A Modbus RTU frame is at most 256 bytes: SlaveAddress, FC, 252 bytes PDU data, CRCL, CRCH
+#define MODBUS_MAX_FRAME_LENGTH		256U
+#define RX_BLOCK_BUFFER_SIZE		MODBUS_MAX_FRAME_LENGTH
+#define MODBUS_FC03_MAX_REGISTERS	125U	// 3 + 250 data + 2 CRC bytes reply
+#define MODBUS_FC16_MAX_REGISTERS	123U	// 7 + 246 data + 2 CRC bytes request
+#define MODBUS_FC23_MAX_WRITE_REGISTERS	121U	// 11 + 242 data + 2 CRC bytes request
+#define MODBUS_FRAME_SLOTS			2U		// Frames are received into the slots in turn
+
+// Modbus RTU character is start + 8 data + parity + stop bits. The frame timer is restarted
+// on the receive complete of each character, so the t1.5 time out includes the time of the
+// next character itself.
+#define MODBUS_BITS_PER_CHAR		11UL
+#define MODBUS_CHAR_TICKS(baud)		((uint16_t)(((MODBUS_BITS_PER_CHAR * FRAME_TIMER_CLOCK) + ((baud) / 2)) / (baud)))
+#define MODBUS_T15_TICKS(charTicks)	((uint16_t)((charTicks) + (charTicks) + ((charTicks) >> 1)))	// 1 char + t1.5
+#define MODBUS_T35_TICKS(charTicks)	((uint16_t)(2 * (charTicks)))									// t1.5 + 2 chars = 1 char + t3.5
+#define MODBUS_TURNAROUND_DEFAULT_TICKS(charTicks)	((uint16_t)((3 * (charTicks)) + ((charTicks) >> 1)))	// t3.5 after request
+#define MODBUS_TURNAROUND_MAX_USEC	(uint16_t)(0xFFFFUL / TURNAROUND_TICKS_PER_USEC)
+
+// Frame slot state enum
+enum {
+	MODBUS_FRAME_FREE,			// Can be received into
+	MODBUS_FRAME_RECEIVING,		// Message being received, left as is if message is dropped
+	MODBUS_FRAME_READY,			// Complete message with good CRC, waiting for MinSlave
+	MODBUS_FRAME_BUSY,			// Taken by MinSlave, until MinUart_releaseFrame()
+};
+
+// Modbus exception codes, reply function code is request function code | MODBUS_EXCEPTION_FLAG
+#define MODBUS_EXCEPTION_FLAG		0x80U
+enum {
+	MODBUS_EXCEPTION_ILLEGAL_FUNCTION = 1,
+	MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS,
+	MODBUS_EXCEPTION_ILLEGAL_DATA_VALUE,
+	MODBUS_EXCEPTION_SLAVE_DEVICE_FAILURE,
+	MODBUS_EXCEPTION_ACKNOWLEDGE,				// Accepted, takes longer than the response time out
+	MODBUS_EXCEPTION_SLAVE_DEVICE_BUSY,			// NFC in use, master should send again later
+};
+
+// frameGap enum, silence on the bus since last character
+enum {
+	MODBUS_GAP_NONE,			// Less than t1.5, next character belongs to current message
+	MODBUS_GAP_T15,				// More than t1.5 but less than t3.5, message is broken
+	MODBUS_GAP_T35,				// More than t3.5, next character is start of new message
+};
 
 enum {
 	MIN_FC03 = 3,
@@ -159,7 +320,14 @@ enum {
 	MODBUS_FC03 = 3,
 	MODBUS_FC04 = 4,
 	MODBUS_FC06 = 6,
+	MODBUS_FC08 = 8,
+	MODBUS_FC11 = 11,
+	MODBUS_FC12 = 12,
 	MODBUS_FC16 = 16,
+	MODBUS_FC22 = 22,
+	MODBUS_FC23 = 23,
+	MODBUS_FC24 = 24,
+	MODBUS_FC43 = 43,
 	MODBUS_FC65_SLAVE_POLL = 65,
 	MODBUS_FC66_BAUDRATE,
 	MODBUS_FC67_DISCOVER,
@@ -169,23 +337,67 @@ enum {
 
 //#define NUMBER_REQUEST_BYTES_FC03 8 // read registers
 #define NUMBER_REQUEST_BYTES_FC03 8 // read registers
+#define NUMBER_REQUEST_BYTES_FC04 8 // read input registers
 #define NUMBER_REQUEST_BYTES_FC06 8 // write setpoint register
+#define NUMBER_REQUEST_BYTES_FC08 8 // SlaveAddress, FC, Sub-function, Data, CRCL, CRCH
+#define NUMBER_REQUEST_BYTES_FC11 4 // Get comm event counter
+#define NUMBER_REQUEST_BYTES_FC12 4 // Get comm event log
 //#define NUMBER_REQUEST_BYTES_FC16 9 // 2 registers but need add number as message comes in. (broadcast block)
 #define NUMBER_REQUEST_BYTES_FC16 11 // 2 registers but need add number as message comes in. (broadcast block)
+#define FIXED_REQUEST_BYTES_FC16  9	 // SlaveAddress, FC, AddressH, AddressL, NumberRegH, NumberRegL, Byte count, CRCL, CRCH
+#define MAX_REQUEST_BYTES_FC16	  (FIXED_REQUEST_BYTES_FC16 + (MODBUS_FC16_MAX_REGISTERS * MODBUS_BYTES_PER_REG))
+#define NUMBER_REQUEST_BYTES_FC22 10 // SlaveAddress, FC, Address, AND mask, OR mask, CRCL, CRCH
+#define FIXED_REQUEST_BYTES_FC23  13 // SlaveAddress, FC, Read address, Read number, Write address, Write number, Byte count, CRC
+#define MIN_REQUEST_BYTES_FC23	  (FIXED_REQUEST_BYTES_FC23 + MODBUS_BYTES_PER_REG)
+#define MAX_REQUEST_BYTES_FC23	  (FIXED_REQUEST_BYTES_FC23 + (MODBUS_FC23_MAX_WRITE_REGISTERS * MODBUS_BYTES_PER_REG))
+#define NUMBER_REQUEST_BYTES_FC24 6 // SlaveAddress, FC, FIFO pointer address, CRCL, CRCH
+#define NUMBER_REQUEST_BYTES_FC43 7 // SlaveAddress, FC, MEI type, ReadDevId code, Object Id, CRCL, CRCH
 #define NUMBER_REQUEST_BYTES_FC65 4 // Slave poll
 #define NUMBER_REQUEST_BYTES_FC66 8 // baud rate
 #define NUMBER_REQUEST_BYTES_FC67 8 // Discover
 #define NUMBER_REQUEST_BYTES_FC69 8
 #define NUMBER_REQUEST_BYTES_FC70 105	//Product Info
+#define MIN_REQUEST_BYTES_FC70	  9		//Product Info with only config code and its CRC
+#define MAX_REQUEST_BYTES_FC70	  (MODBUS_MAX_FRAME_LENGTH - 1)	// Length byte is 8 bit
 #define INITIALIZED				  0x5A5A //Min permission to save
 
+// Function code descriptor. The descriptor table is indexed by function code, an entry
+// with no handler is a function code that is not supported.
+// Request length is minLength when lengthIndex is 0, otherwise it is the request byte at
+// lengthIndex plus lengthAdd, which must be from minLength to maxLength.
+#define MODBUS_FUNCTION_CODES	(MIN_FC70_STORE_PRODUCT_INFO + 1)	// Size of descriptor table
+
+typedef struct MinFunction_STYP{
+	uint8_t lengthIndex;		// Index of request length byte, 0 = fixed length request
+	uint8_t lengthAdd;			// Added to request length byte
+	uint8_t minLength;			// Shortest request, length of fixed length request
+	uint8_t maxLength;			// Longest request
+	bool broadcastOK;			// Accepted when sent to MODBUS_MASTER_BROADCAST address
+	void (*handler)(void);		// Called from MinSlave_manageMessages(), uses the frame taken
+} MinFunction_STYP;
+
+typedef struct MinFrame_STYP{
+	volatile uint8_t state;		// See frame slot state enum
+	uint8_t exceptionCode;		// Not 0 when request could not be framed from its descriptor, reply with it
+	uint8_t data[RX_BLOCK_BUFFER_SIZE];	// Written by receive ISR while RECEIVING
+} MinFrame_STYP;
+#define MIN_FRAME_DEFAULTS	{MODBUS_FRAME_FREE, 0, {0}}
+
+// List of bus counters, counted by the receive ISR and read with MinUart_copyCounters()
+enum uartCounterNumbers {
+	MIN_UART_BUS_MESSAGE_CNUM = 0,		// Messages started on the bus, any address
+	MIN_UART_CRC_ERROR_CNUM,			// Messages with bad CRC, any address
+	MIN_UART_OVERRUN_CNUM,				// USART receive overruns, characters lost
+	MIN_UART_FRAMING_ERROR_CNUM,		// Characters without stop bit
+	MIN_UART_NUMBER_OF_COUNTERS
+};
+
 typedef struct MinUart_STYP{
 
 	// Public Variables
-	uint8_t modbusReSync;		// 1msec count down timer for resyncing communications.
-	uint8_t rxBuffer[RX_BLOCK_BUFFER_SIZE];
+	volatile uint8_t frameGap;	// Set by frame timer ISR, see frameGap enum.
+	MinFrame_STYP frame[MODBUS_FRAME_SLOTS];
 	uint8_t moduleAddress;		// Stores the slave address
-	uint8_t processPacketFlag;	// Set when at end of message and checksum is OK
 	uint8_t baudSelect;			// See Build.h for selection enum
 
 	// Private Variables (Multi-instance methods only)
@@ -194,18 +406,38 @@ typedef struct MinUart_STYP{
 	uint16_t rxBufferIndex;
 	uint8_t functionCode;
 	uint8_t  currentState;
+	uint16_t charTicks;			// Frame timer ticks per character at selected baud rate
+	uint16_t turnaroundTicks;	// Time from end of request to start of reply, turnaround timer ticks
+	uint16_t rxCrc;				// Running CRC of the message being received
+	uint8_t rxSlot;				// Slot the next message is received into
+	uint8_t processSlot;		// Slot MinSlave takes the next message from
+	const __flash MinFunction_STYP *pFunctionTable;	// Function code descriptor table, set by MinSlave
+	const __flash MinFunction_STYP *pFunction;		// Descriptor of message being received
+	uint16_t counters[MIN_UART_NUMBER_OF_COUNTERS];	// See uartCounterNumbers, wrap around at 0xFFFF
 } MinUart_STYP;
-#define MIN_UART_DEFAULTS  {0,					\
-							{0},				\
+#define MIN_UART_DEFAULTS  {MODBUS_GAP_T35,		\
+							{MIN_FRAME_DEFAULTS, MIN_FRAME_DEFAULTS},	\
 							NFC_BASE_ADDRESS,	\
-							0, 					\
 							BR_SELECT_115200,	\
 							0,0,0,0,0,			\
+							MODBUS_CHAR_TICKS(115200UL),	\
+							MODBUS_TURNAROUND_DEFAULT_TICKS(MODBUS_CHAR_TICKS(115200UL)),	\
+							0xFFFF,				\
+							0,0,				\
+							((void*)0),((void*)0),	\
+							{0},				\
 						   }
 
 void MinUart_init(MinUart_STYP *);
 void MinUart_serviceRx(MinUart_STYP *);
 void MinUart_serviceTx(MinUart_STYP *);
+void MinUart_serviceFrameTimer(MinUart_STYP *);
+void MinUart_setTurnaround(MinUart_STYP *, uint16_t usec);
+uint8_t *MinUart_getFrame(MinUart_STYP *, uint8_t *exceptionCode);
+void MinUart_releaseFrame(MinUart_STYP *, uint8_t *data);
+void MinUart_copyCounters(MinUart_STYP *, uint16_t *pDest);
+void MinUart_clearCounters(MinUart_STYP *);
 uint16_t get_crc_16 (uint16_t start, uint8_t *p, uint16_t n);
+uint16_t update_crc_16 (uint16_t crc, uint8_t data);
 
 #endif /* MIN_UART_H_ */
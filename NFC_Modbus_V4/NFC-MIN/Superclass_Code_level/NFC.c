@@ -32,6 +32,50 @@ Originator:   Anish Venkataraman
 					Added NFC_PageWrite(),NFC_getBroadcastBlkAddress()
 					NFC_getUpdateBlkAddress() 
 1.09	09-10-2020  Updated NFC_Init() 1.02		 					 Anish Venkataraman
+1.10	10-16-2026  Added NFC_isBusy()
+1.11	10-16-2026  Added nfcRegionTable[] memory map and NFC_checkAccess()
+1.12	10-16-2026  Added NFC_compareWrite(), page compare and write loop
+					moved from Scheduler.c
+1.13	10-16-2026  NFC_PageWrite() 1.01, NFC_compareWrite() 1.01
+					Event log region at the top of memory, read only
+1.14	10-16-2026  Added NFC_StreamRead()
+1.15	10-16-2026  Reads served from a RAM cache of NFC_CACHE_LINES lines,
+					NFC_SequentialRead() 1.02, NFC_StreamRead() 1.01,
+					NFC_ReadByte() 1.01, NFC_WriteByte() 1.02,
+					NFC_InstantaneousWrite() 1.04, NFC_PageWrite() 1.02
+					Added NFC_readDevicePRIV(), NFC_cacheLinePRIV() and
+					NFC_cacheInvalidatePRIV()
+1.16	10-16-2026  Added NFC_prefetch() and NFC_trackReadPRIV(), ascending scans
+					read ahead, NFC_SequentialRead() 1.03, NFC_StreamRead() 1.02
+1.17	10-16-2026  Added write back pages, NFC_bufferWrite(), NFC_writeBackDue(),
+					NFC_writeBackFlush(), NFC_findDirtyPagePRIV(),
+					NFC_overlayDirtyPRIV() and NFC_cacheFindPRIV()
+					NFC_cacheLinePRIV() 1.01, NFC_compareWrite() 1.02
+1.18	10-16-2026  Added NFC_isWriting(), NFC_pendingByte() and NFC_overlayPending()
+					so reads return data of writes flagged for the Scheduler
+1.19	10-16-2026  Added per region write policies, NFC_takeWrite(), NFC_policyTick(),
+					NFC_savePolicy() and NFC_loadPolicyPRIV(), policy region below
+					the event log, NFC_init() 1.03, NFC_checkAccess() 1.01,
+					NFC_writeBackDue() 1.01, NFC_writeBackFlush() 1.01
+1.20	10-16-2026  Added broadcast fingerprints, NFC_broadcastUnchanged(),
+					NFC_broadcastStored(), NFC_fingerprintCrcPRIV() and
+					NFC_fingerprintInvalidatePRIV(), NFC_WriteByte() 1.03,
+					NFC_InstantaneousWrite() 1.05, NFC_PageWrite() 1.03,
+					NFC_bufferWrite() 1.01
+					NFC_getBroadcastBlkAddress() 1.01 returns the broadcast address
+1.21	10-16-2026  Added region digests, NFC_digestUpdate(), NFC_digestReady(),
+					NFC_pageWritePRIV(), NFC_regionPRIV(), NFC_digestPagePRIV() and
+					NFC_digestStalePRIV(), NFC_PageWrite() 1.04,
+					NFC_writeBackFlush() 1.02
+1.22	10-16-2026  NFC_takeWrite() split into NFC_writeAllowed() and NFC_countWrite(),
+					a write is counted only once it is taken
+1.23	10-16-2026  NFC_WriteByte() 1.04 and NFC_InstantaneousWrite() 1.06 mark the
+					region digest stale
+1.24	10-16-2026  NFC_digestPagePRIV() 1.01 splits a page written across a region
+					end or the digest read position, NFC_pageWritePRIV() 1.01
+1.25	10-16-2026  NFC_digestReady() 1.01 not ready while a write to the region is
+					pending, added NFC_inRegionPRIV()
+1.26	10-16-2026  NFC_compareWrite() 1.03 returns NFC_WRITE_UNCHANGED
  ---------------------------------------------------------------------------------------
  */
 #include "I2cDrive.h"
@@ -39,9 +83,72 @@ Originator:   Anish Venkataraman
 #include "stdint-gcc.h"
 #include "NFC.h"
 
+//NFC memory map, regions in address order from 0 up to NFC_MEM_SIZE with no gaps.
+//Modbus register number n is NFC byte address n * 2.
+static const __flash NFCRegion_STYP nfcRegionTable[NFC_REGIONS] = {
+//	start				end					access
+	{0x0000,			BLOCK_NVM_OFFSET,	NFC_REGION_READ | NFC_REGION_WRITE},	//Below product info
+	{BLOCK_NVM_OFFSET,	BLOCK2_OFFSET,		NFC_REGION_READ | NFC_REGION_WRITE},	//Product info FC69/FC70, holding registers from HOLDING_REG_OFFSET
+	{BLOCK2_OFFSET,		BLOCK11_OFFSET,		NFC_REGION_READ | NFC_REGION_WRITE},	//Block 2
+	{BLOCK11_OFFSET,	BLOCK226_OFFSET,	NFC_REGION_READ | NFC_REGION_WRITE},	//Block 11
+	{BLOCK226_OFFSET,	NFC_POLICY_OFFSET,	NFC_REGION_READ | NFC_REGION_WRITE},	//Block 226 up to write policies
+	{NFC_POLICY_OFFSET,	NFC_EVENT_LOG_OFFSET,	NFC_REGION_READ},						//Write policies, written by NFC_savePolicy() only
+	{NFC_EVENT_LOG_OFFSET,	NFC_MEM_SIZE,	NFC_REGION_READ},						//Event log, written by EventLog_flush() only
+};
+
 
 extern MinSlave_STYP oMinSlave;
 
+//Read cache, NFC_CACHE_LINES lines of NFC_CACHE_LINE_SIZE bytes. Tag is the line
+//number + 1, 0 = empty. Lines written by this firmware are dropped, the NFC is
+//expected not to be written from RF while powered.
+static uint8_t cacheTag[NFC_CACHE_LINES];
+static uint8_t cacheData[NFC_CACHE_LINES][NFC_CACHE_LINE_SIZE];
+static uint8_t cacheReferenced = 0;		//One bit per line, set when used
+static uint8_t cacheHand = 0;			//Clock hand, next line looked at for replacement
+
+//Read ahead, see NFC_trackReadPRIV()
+static uint16_t lastReadEnd = 0xFFFF;	//Address after the last read
+static uint16_t prefetchAddress = 0;	//Next address NFC_prefetch() reads up to prefetchEnd
+static uint16_t prefetchEnd = 0;
+
+//Write back, Modbus writes held in RAM until NFC_writeBackFlush(), see NFC_bufferWrite()
+static NFCDirtyPage_STYP dirtyPage[NFC_WRITE_BACK_PAGES];
+static uint8_t dirtyPages = 0;			//Slots of dirtyPage[] used
+static uint16_t writeBackIdleMsec = 0;	//Since the last write was taken
+static uint16_t writeBackAgeMsec = 0;	//Since the oldest pending write was taken
+static bool writeBackNow = FALSE;		//NFC_POLICY_IMMEDIATE write taken, flush without waiting
+
+//Write policy, region i of nfcRegionTable[] set by MIN_SLAVE_REGION0_POLICY_RNUM + i
+static uint8_t policyWrites[NFC_POLICY_REGIONS];	//Writes taken this interval
+static uint16_t policyMinutes = 0;		//Since the interval started
+
+//Broadcast blocks stored, dropped when this firmware writes their bytes
+static NFCFingerprint_STYP fingerprint[NFC_FINGERPRINTS];
+static uint8_t fingerprintNext = 0;		//Entry replaced when none is free
+
+//Region digests, CRC-16 kept in MIN_SLAVE_REGION0_DIGEST_RNUM + region, see NFC_digestUpdate()
+static uint8_t digestStale = (1 << NFC_REGIONS) - 1;	//Bit per region whose digest is not computed
+static uint8_t digestRegion = 0;		//Region NFC_digestUpdate() computes
+static uint16_t digestAddress = 0;		//Next address of digestRegion read into its CRC
+
+//Private Method Prototypes
+static void NFC_readDevicePRIV(uint16_t address, uint8_t length, uint8_t *data);
+static uint8_t *NFC_cacheLinePRIV(uint16_t address);
+static void NFC_cacheInvalidatePRIV(uint16_t address, uint8_t length);
+static void NFC_trackReadPRIV(uint16_t address, uint8_t length);
+static uint8_t NFC_cacheFindPRIV(uint16_t address);
+static uint8_t NFC_findDirtyPagePRIV(uint16_t page);
+static void NFC_overlayDirtyPRIV(uint16_t address, uint8_t *data, uint16_t length, bool newer);
+static void NFC_loadPolicyPRIV(void);
+static uint16_t NFC_fingerprintCrcPRIV(uint8_t *pData, uint8_t length);
+static void NFC_fingerprintInvalidatePRIV(uint16_t address, uint16_t length);
+static uint8_t NFC_pageWritePRIV(uint16_t address, uint8_t *old, uint8_t *data);
+static uint8_t NFC_regionPRIV(uint16_t address);
+static void NFC_digestPagePRIV(uint16_t address, uint8_t *old, uint8_t *data);
+static void NFC_digestStalePRIV(uint8_t region);
+static bool NFC_inRegionPRIV(uint8_t region, uint16_t address, uint16_t length);
+
 
 /*=======================================================================================
 Method name:  NFC_WriteByte(uint16_t address, unsigned char data)
@@ -63,8 +170,14 @@ History:
 1.00    9-10-2019   Original code                                   Anish Venkataraman
 1.01	11-21-2019	Changed the name of the function from NFC_Write Anish Venkataraman
 					to NFC_WriteByte
+1.02	10-16-2026	Drops the cached line
+1.03	10-16-2026	Drops the broadcast fingerprint
+1.04	10-16-2026	Marks the region digest stale
 ---------------------------------------------------------------------------------------*/
 void NFC_WriteByte(uint16_t address, unsigned char data) {
+	NFC_cacheInvalidatePRIV(address, 1);
+	NFC_fingerprintInvalidatePRIV(address, 1);
+	NFC_digestStalePRIV(NFC_regionPRIV(address));
 	I2cDrive_Start();
 	(void)I2cDrive_SendByte(NFC_ADDRESS_Write);
 	(void)I2cDrive_SendByte(address >> MSB_MASK);
@@ -90,9 +203,15 @@ History:
 					refactored the code
 1.03    08-28-2020  Function was returning nothing so modified it to  Anish Venkataraman
 					void
+1.04    10-16-2026  Drops the cached line
+1.05    10-16-2026  Drops the broadcast fingerprint
+1.06    10-16-2026  Marks the region digest stale
 ---------------------------------------------------------------------------------------*/
 
 void NFC_InstantaneousWrite(NFC_STYP *nfc, uint16_t address, uint16_t data) {
+	NFC_cacheInvalidatePRIV(address, 2);
+	NFC_fingerprintInvalidatePRIV(address, 2);
+	NFC_digestStalePRIV(NFC_regionPRIV(address));
 	I2cDrive_Start();
 	(void)I2cDrive_SendByte(NFC_ADDRESS_Write);
 	(void)I2cDrive_SendByte(address >> MSB_MASK);
@@ -122,19 +241,10 @@ Description: It takes a 16-bit address and returns one byte of data. It performs
 History:
  *-------*-----------*---------------------------------------------------*--------------
 1.00    9-10-2019   Original code                                   Anish Venkataraman
+1.01    10-16-2026  Read through the cache
 ---------------------------------------------------------------------------------------*/
 uint8_t NFC_ReadByte(uint16_t address) {
-	uint8_t data = 0;
-	I2cDrive_Start();
-	(void)I2cDrive_SendByte(NFC_ADDRESS_Write);
-	(void)I2cDrive_SendByte(address >> MSB_MASK);
-	(void)I2cDrive_SendByte(address & LSB_MASK);
-	I2cDrive_Start();
-	(void)I2cDrive_SendByte(NFC_ADDRESS_Read);
-	data = I2cDrive_ReceiveByte();
-	I2cDrive_NAckSend();
-	I2cDrive_Stop();
-	return data;
+	return NFC_cacheLinePRIV(address)[address % NFC_CACHE_LINE_SIZE];
 }
 
 /*=======================================================================================
@@ -173,6 +283,7 @@ Originator:   Anish Venkataraman
 
 Description: Initialization method for NFC. Reads the configuration code from NFC and
 			 stores the value in the nfc object and Minslave object as well.	 
+			 Loads the write policies saved in the NFC.
 
 
 =======================================================================================
@@ -183,6 +294,7 @@ History:
 					 to 0x5a5a
 1.02    09-10-2020   Updated the NFC config assignment LSB first     Anish Venkataraman
 					 and then MSB
+1.03    10-16-2026   Load write policies
 ---------------------------------------------------------------------------------------*/
 
 void NFC_init(NFC_STYP *nfc) {
@@ -197,6 +309,7 @@ void NFC_init(NFC_STYP *nfc) {
 		oMinSlave.slaveRegisters[MIN_SLAVE_MODEL_CONFIGURATION_CODE] = 0; 
 		oMinSlave.slaveRegisters[MIN_SLAVE_EEPROM_INIT_VALUE_RNUM] = 0;
 	}
+	NFC_loadPolicyPRIV();
 }
 
 /*=======================================================================================
@@ -204,8 +317,40 @@ Method name:  NFC_SequentialRead
 
 Originator:   Anish Venkataraman
 
-Description: It takes a 16-bit address and a pointer to the sequence of data. It performs a
-sequential read access to the NFC chip. This process is done as follows
+Description: It takes a 16-bit address and a pointer to the sequence of data. Copies
+length bytes from the cache lines holding them, lines not cached are read from the NFC
+with NFC_readDevicePRIV() one line at a time.
+
+Note: Max 255 characters can be read in one sequential read command
+=======================================================================================
+History:
+ *-------*-----------*-----------------------------------------------*-------------------
+1.00    06-26-2020   Original code                                   Anish Venkataraman
+1.01    07-07-2020   Removed NFC_STYP parameter passed				 Anish Venkataraman
+1.02    10-16-2026   Read through the cache, I2C read moved to NFC_readDevicePRIV()
+1.03    10-16-2026   Ascending scans read ahead
+---------------------------------------------------------------------------------------*/
+
+void NFC_SequentialRead(uint16_t address, uint8_t length, uint8_t *data) {
+	uint8_t *pLine;
+	uint8_t offset;
+
+	NFC_trackReadPRIV(address, length);
+	while(length > 0){
+		pLine = NFC_cacheLinePRIV(address);
+		for(offset = address % NFC_CACHE_LINE_SIZE; offset < NFC_CACHE_LINE_SIZE && length > 0; offset++, length--, address++){
+			*data++ = pLine[offset];
+		}
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_readDevicePRIV
+
+Originator:   Anish Venkataraman
+
+Description: Sequential read access to the NFC chip over I2C, the read behind the
+cache. This process is done as follows
 1. Send I2C Start Signal
 2. Slave Select + R/W(set to 0) -> Device Address
 3. Send MSB-Byte address to be read followed by LSB-Byte address.
@@ -213,16 +358,12 @@ sequential read access to the NFC chip. This process is done as follows
 5. Receive data by calling I2cDrive_ReceiveByte method(function).
 6. Receive data for the specified length
 7. Send I2C Stop Signal
-
-Note: Max 256 characters can be written in one sequential write command
 =======================================================================================
 History:
  *-------*-----------*-----------------------------------------------*-------------------
-1.00    06-26-2020   Original code                                   Anish Venkataraman
-1.01    07-07-2020   Removed NFC_STYP parameter passed				 Anish Venkataraman
+1.00    10-16-2026   Moved from NFC_SequentialRead()
 ---------------------------------------------------------------------------------------*/
-
-void NFC_SequentialRead(uint16_t address, uint8_t length, uint8_t *data) {
+static void NFC_readDevicePRIV(uint16_t address, uint8_t length, uint8_t *data) {
 	uint8_t i;
 	I2cDrive_Start();
 	(void)I2cDrive_SendByte(NFC_ADDRESS_Write);
@@ -243,6 +384,172 @@ void NFC_SequentialRead(uint16_t address, uint8_t length, uint8_t *data) {
 	I2cDrive_Stop();
 }
 
+/*=======================================================================================
+Method name:  NFC_cacheLinePRIV
+
+Originator:   
+
+Description: Returns the cache line holding address. On a miss the line is read from
+the NFC into the slot picked by the clock hand: lines referenced since the hand last
+passed get a second chance, the first one that was not is replaced. Write back bytes
+not written yet are copied over the line read.
+=======================================================================================
+History:
+ *-------*-----------*-----------------------------------------------*-------------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Write back bytes copied over the line read
+---------------------------------------------------------------------------------------*/
+static uint8_t *NFC_cacheLinePRIV(uint16_t address) {
+	uint8_t i;
+	uint8_t tag = (uint8_t)((address / NFC_CACHE_LINE_SIZE) + 1);
+
+	i = NFC_cacheFindPRIV(address);
+	if(i < NFC_CACHE_LINES){
+		cacheReferenced |= (uint8_t)(1 << i);
+		return cacheData[i];
+	}
+	while(cacheReferenced & (uint8_t)(1 << cacheHand)){
+		cacheReferenced &= (uint8_t)~(1 << cacheHand);
+		cacheHand = (cacheHand + 1) % NFC_CACHE_LINES;
+	}
+	i = cacheHand;
+	cacheHand = (cacheHand + 1) % NFC_CACHE_LINES;
+	cacheTag[i] = 0;
+	address = address & ~(NFC_CACHE_LINE_SIZE - 1);
+	NFC_readDevicePRIV(address, NFC_CACHE_LINE_SIZE, cacheData[i]);
+	NFC_overlayDirtyPRIV(address, cacheData[i], NFC_CACHE_LINE_SIZE, FALSE);
+	cacheTag[i] = tag;
+	cacheReferenced |= (uint8_t)(1 << i);
+	return cacheData[i];
+}
+
+/*=======================================================================================
+Method name:  NFC_cacheFindPRIV
+
+Originator:   
+
+Description: Returns the cache line holding address, NFC_CACHE_LINES if it is not cached.
+=======================================================================================
+History:
+ *-------*-----------*-----------------------------------------------*-------------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static uint8_t NFC_cacheFindPRIV(uint16_t address) {
+	uint8_t i;
+	uint8_t tag = (uint8_t)((address / NFC_CACHE_LINE_SIZE) + 1);
+
+	for(i = 0; i < NFC_CACHE_LINES; i++){
+		if(cacheTag[i] == tag){
+			break;
+		}
+	}
+	return i;
+}
+
+/*=======================================================================================
+Method name:  NFC_cacheInvalidatePRIV
+
+Originator:   
+
+Description: Drops the cache lines holding address up to address + length, called
+when this firmware writes the NFC.
+=======================================================================================
+History:
+ *-------*-----------*-----------------------------------------------*-------------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static void NFC_cacheInvalidatePRIV(uint16_t address, uint8_t length) {
+	uint8_t i;
+	uint8_t first = (uint8_t)((address / NFC_CACHE_LINE_SIZE) + 1);
+	uint8_t last = (uint8_t)(((address + length - 1) / NFC_CACHE_LINE_SIZE) + 1);
+
+	for(i = 0; i < NFC_CACHE_LINES; i++){
+		if(cacheTag[i] >= first && cacheTag[i] <= last){
+			cacheTag[i] = 0;
+		}
+	}
+}
+/*=======================================================================================
+Method name:  NFC_prefetch
+
+Originator:   
+
+Description: Called every pass of the main loop. When the last reads were an ascending
+scan, see NFC_trackReadPRIV(), reads one line of the next window into the cache so the
+next request is answered without the I2C bus. One line per call keeps the main loop
+back to MinSlave_manageMessages() quickly. Nothing is read while an NFC write is
+pending.
+=======================================================================================
+History:
+ *-------*-----------*-----------------------------------------------*-------------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+void NFC_prefetch(NFC_STYP *nfc) {
+	if(prefetchAddress >= prefetchEnd || NFC_isBusy(nfc)){
+		return;
+	}
+	(void)NFC_cacheLinePRIV(prefetchAddress);
+	prefetchAddress = (prefetchAddress & ~(NFC_CACHE_LINE_SIZE - 1)) + NFC_CACHE_LINE_SIZE;
+}
+
+/*=======================================================================================
+Method name:  NFC_trackReadPRIV
+
+Originator:   
+
+Description: Called for each read. A read starting where the last one ended is taken as
+an ascending scan and the window after it, up to NFC_PREFETCH_LINES lines, is set up
+for NFC_prefetch(). Any other read stops the prefetch.
+=======================================================================================
+History:
+ *-------*-----------*-----------------------------------------------*-------------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static void NFC_trackReadPRIV(uint16_t address, uint8_t length) {
+	uint16_t end = address + length;
+
+	prefetchAddress = end;
+	prefetchEnd = end;
+	if(address == lastReadEnd){
+		prefetchEnd = end + ((length < (NFC_PREFETCH_LINES * NFC_CACHE_LINE_SIZE)) ? length : (NFC_PREFETCH_LINES * NFC_CACHE_LINE_SIZE));
+		if(prefetchEnd > NFC_MEM_SIZE){
+			prefetchEnd = NFC_MEM_SIZE;
+		}
+	}
+	lastReadEnd = end;
+}
+
+
+/*=======================================================================================
+Method name:  NFC_StreamRead
+
+Originator:   
+
+Description: Read like NFC_SequentialRead() that hands each byte to byteRead()
+instead of storing it, so the caller can use it while the rest is still being read.
+Cached lines are handed over at once, others as soon as the line is read.
+
+Note: byteRead() must not use the I2C bus.
+=======================================================================================
+History:
+ *-------*-----------*-----------------------------------------------*-------------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Read through the cache
+1.02    10-16-2026   Ascending scans read ahead
+---------------------------------------------------------------------------------------*/
+void NFC_StreamRead(uint16_t address, uint8_t length, void (*byteRead)(uint8_t data)) {
+	uint8_t *pLine;
+	uint8_t offset;
+
+	NFC_trackReadPRIV(address, length);
+	while(length > 0){
+		pLine = NFC_cacheLinePRIV(address);
+		for(offset = address % NFC_CACHE_LINE_SIZE; offset < NFC_CACHE_LINE_SIZE && length > 0; offset++, length--, address++){
+			byteRead(pLine[offset]);
+		}
+	}
+}
+
 /*=======================================================================================
 Method name:  NFC_getUpdateBlkAddress()
 
@@ -276,12 +583,14 @@ Method name:  NFC_getBroadcastBlkAddress()
 Originator:   Anish Venkataraman
 
 Description: Getter method for obtaining the address for the block to update 	 
-
+			 broadcast.registerNumber already holds the NFC byte address.
 
 =======================================================================================
 History:
  *-------*-----------*---------------------------------------------------*--------------
 1.00    08-28-2020   Original code                                   Anish Venkataraman
+1.01    10-16-2026   Returns the broadcast address, was the address of
+					 the last write addressed to the NFC
 ---------------------------------------------------------------------------------------*/
 uint16_t NFC_getBroadcastBlkAddress(NFC_STYP *nfc){
 	/*
@@ -299,7 +608,7 @@ uint16_t NFC_getBroadcastBlkAddress(NFC_STYP *nfc){
 	}
 	*/
 //	return (HOLDING_REG_OFFSET + (nfc->broadcast.registerNumber *2));
-	return ((nfc->update.registerNumber)*2);
+	return (nfc->broadcast.registerNumber);
 }
 
 /*=======================================================================================
@@ -307,20 +616,926 @@ Method name:  NFC_PageWrite()
 
 Originator:   Anish Venkataraman
 
-Description: Method for writing one page i.e 32 bytes to the NFC
+Description: Method for writing one page i.e 32 bytes to the NFC. Returns
+			 NFC_WRITE_ERR if a byte was not acknowledged. The page is read first
+			 for the region digest, see NFC_pageWritePRIV().
 =======================================================================================
 History:
  *-------*-----------*---------------------------------------------------*--------------
 1.00    08-28-2020   Original code                                   Anish Venkataraman
+1.01    10-16-2026   Return write error
+1.02    10-16-2026   Drops the cached line
+1.03    10-16-2026   Drops the broadcast fingerprint
+1.04    10-16-2026   Write moved to NFC_pageWritePRIV()
 ---------------------------------------------------------------------------------------*/
-void NFC_PageWrite(uint16_t address, uint8_t *data) {
+uint8_t NFC_PageWrite(uint16_t address, uint8_t *data) {
+	uint8_t old[BYTES_IN_PAGE];
+
+	NFC_readDevicePRIV(address, BYTES_IN_PAGE, old);	//not the cache, it can hold pending writes
+	return NFC_pageWritePRIV(address, old, data);
+}
+
+/*=======================================================================================
+Method name:  NFC_pageWritePRIV()
+
+Originator:   
+
+Description: Writes one page (BYTES_IN_PAGE) of data to the NFC, old is the page as
+			 the NFC holds it. Drops the cached line and broadcast fingerprints and
+			 updates the region digest from the bytes that change. Returns
+			 NFC_WRITE_ERR if a byte was not acknowledged, the digest of the regions
+			 written is then computed again.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Moved from NFC_PageWrite()
+1.01    10-16-2026   Write error marks both regions of a page across a region end
+---------------------------------------------------------------------------------------*/
+static uint8_t NFC_pageWritePRIV(uint16_t address, uint8_t *old, uint8_t *data) {
 	uint8_t i = 0;
+	uint8_t err;
+	NFC_cacheInvalidatePRIV(address, BYTES_IN_PAGE);
+	NFC_fingerprintInvalidatePRIV(address, BYTES_IN_PAGE);
 	I2cDrive_Start();
-	(void)I2cDrive_SendByte(NFC_ADDRESS_Write);
-	(void)I2cDrive_SendByte(address >> MSB_MASK);
-	(void)I2cDrive_SendByte(address & LSB_MASK);
+	err = I2cDrive_SendByte(NFC_ADDRESS_Write);
+	err |= I2cDrive_SendByte(address >> MSB_MASK);
+	err |= I2cDrive_SendByte(address & LSB_MASK);
 	for(i = 0; i < BYTES_IN_PAGE; i++){
-		I2cDrive_SendByte(*data++);
+		err |= I2cDrive_SendByte(data[i]);
 	}
 	I2cDrive_Stop();
-}
\ No newline at end of file
+	if(err){
+		NFC_digestStalePRIV(NFC_regionPRIV(address));	//page may hold either
+		NFC_digestStalePRIV(NFC_regionPRIV(address + BYTES_IN_PAGE - 1));
+		return NFC_WRITE_ERR;
+	}
+	NFC_digestPagePRIV(address, old, data);
+	return NO_WRITE_ERR;
+}
+
+/*=======================================================================================
+Method name:  NFC_isBusy()
+
+Originator:   
+
+Description: Returns TRUE while an NFC write is pending or being written by the
+			 Scheduler. The NFC does not answer on I2C while it writes a page and
+			 the object holds one pending write, so requests that write the NFC are
+			 answered busy until this is FALSE. Reads only wait for NFC_isWriting().
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+bool NFC_isBusy(NFC_STYP *nfc) {
+	return (nfc->instantWriteFLG || nfc->productInfoFLG || nfc->storeBroadcastFLG ||
+			nfc->schedulerNFCWriteWait);
+}
+/*=======================================================================================
+Method name:  NFC_isWriting()
+
+Originator:   
+
+Description: Returns TRUE while the NFC is writing a page and does not answer on I2C.
+			 A write that is only pending does not stop a read, the read takes the
+			 pending data with NFC_pendingByte().
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+bool NFC_isWriting(NFC_STYP *nfc) {
+	return nfc->schedulerNFCWriteWait;
+}
+
+/*=======================================================================================
+Method name:  NFC_pendingByte()
+
+Originator:   
+
+Description: Returns the byte at address as it will be once the writes flagged for the
+			 Scheduler are done: the byte of the pending update, broadcast or product
+			 info write covering address, else data as read from the NFC.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+uint8_t NFC_pendingByte(NFC_STYP *nfc, uint16_t address, uint8_t data) {
+	uint16_t start;
+
+	if(nfc->instantWriteFLG){
+		start = NFC_getUpdateBlkAddress(nfc);
+		if(address >= start && address < start + nfc->update.length){
+			data = nfc->update.pNfcData[address - start];
+		}
+	}
+	if(nfc->storeBroadcastFLG){
+		start = NFC_getBroadcastBlkAddress(nfc);
+		if(address >= start && address < start + nfc->broadcast.length){
+			data = nfc->broadcast.pNfcData[address - start];
+		}
+	}
+	if(nfc->productInfoFLG){
+		if(address >= BLOCK_NVM_OFFSET && address < BLOCK_NVM_OFFSET + nfc->productInfoLength){
+			data = nfc->pProductInfoData[address - BLOCK_NVM_OFFSET];
+		}
+	}
+	return data;
+}
+
+/*=======================================================================================
+Method name:  NFC_overlayPending()
+
+Originator:   
+
+Description: Applies NFC_pendingByte() to length bytes read from address into pData.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+void NFC_overlayPending(NFC_STYP *nfc, uint16_t address, uint8_t *pData, uint8_t length) {
+	if(!(nfc->instantWriteFLG || nfc->storeBroadcastFLG || nfc->productInfoFLG)){
+		return;
+	}
+	for(; length > 0; length--, address++, pData++){
+		*pData = NFC_pendingByte(nfc, address, *pData);
+	}
+}
+
+
+/*=======================================================================================
+Method name:  NFC_checkAccess()
+
+Originator:   
+
+Description: Checks length bytes from address against the memory map. Returns TRUE
+			 if all bytes are inside NFC memory and every region they are in allows
+			 access (NFC_REGION_READ and/or NFC_REGION_WRITE), otherwise FALSE.
+			 NFC_REGION_WRITE is not allowed in a region set to NFC_POLICY_READ_ONLY.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Write policy NFC_POLICY_READ_ONLY
+---------------------------------------------------------------------------------------*/
+bool NFC_checkAccess(uint16_t address, uint16_t length, uint8_t access) {
+	uint8_t i;
+	uint16_t end;
+
+	if ((length == 0) || (address >= NFC_MEM_SIZE) || (length > (uint16_t)(NFC_MEM_SIZE - address))) {
+		return FALSE;
+	}
+	end = address + length;
+	for (i = 0; (i < NFC_REGIONS) && (address < end); i++) {
+		if ((address >= nfcRegionTable[i].start) && (address < nfcRegionTable[i].end)) {
+			if ((nfcRegionTable[i].access & access) != access) {
+				return FALSE;
+			}
+			if ((access & NFC_REGION_WRITE) && (i < NFC_POLICY_REGIONS) &&
+				((oMinSlave.slaveRegisters[MIN_SLAVE_REGION0_POLICY_RNUM + i] >> NFC_POLICY_SHIFT) == NFC_POLICY_READ_ONLY)) {
+				return FALSE;
+			}
+			address = nfcRegionTable[i].end;	//next byte is in the next region
+		}
+	}
+	return (address >= end);
+}
+
+/*=======================================================================================
+Method name:  NFC_compareWrite()
+
+Originator:   
+
+Description: Writes length bytes from pData to the NFC from address, one page
+			 (BYTES_IN_PAGE) at a time. Each page is read first and only written if
+			 it is different. Bytes of the last page past the end of the data are
+			 written back as read. After a page write it waits for the write cycle
+			 (schedulerNFCWriteWait, cleared by the 1 msec timer interrupt) and calls
+			 whileWaiting meanwhile if it is not 0. Returns NFC_WRITE_ERR if a page
+			 write was not acknowledged, the other pages are still written, and
+			 NFC_WRITE_UNCHANGED if the NFC already held the data so no page was
+			 written.
+			 Write back bytes pending in the range take the new data, writes taken
+			 with NFC_bufferWrite() are older as they are refused while a write is
+			 flagged.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Broke out of Scheduler_writeInstant(),
+					 Scheduler_writeBroadcast() and Scheduler_writeProductInfo()
+1.01    10-16-2026   Return write error
+1.02    10-16-2026   Pending write back bytes take the new data
+1.03    10-16-2026   Return NFC_WRITE_UNCHANGED when no page was written
+---------------------------------------------------------------------------------------*/
+uint8_t NFC_compareWrite(NFC_STYP *nfc, uint16_t address, uint8_t *pData, uint16_t length, void (*whileWaiting)(void)) {
+	uint16_t i;
+	uint16_t index = 0;
+	uint8_t count;
+	uint8_t j;
+	uint8_t err = NFC_WRITE_UNCHANGED;
+	uint8_t data[BYTES_IN_PAGE];
+
+	NFC_overlayDirtyPRIV(address, pData, length, TRUE);
+	for(i = address; i < address + length; i = i + BYTES_IN_PAGE){
+		//Read data before writing
+		NFC_SequentialRead(i,BYTES_IN_PAGE,data);
+		count = 0;
+		for(j = 0; j < BYTES_IN_PAGE; j++, index++){
+			if(index >= length || data[j] == pData[index]){
+				count++;	//past end of data NFC byte is written back as read
+			}
+			else {
+				data[j] = pData[index];
+			}
+		}
+		if(count != BYTES_IN_PAGE){//data is different so write the page
+			if(NFC_PageWrite(i,data) != NO_WRITE_ERR){
+				err = NFC_WRITE_ERR;
+			}
+			else if(err == NFC_WRITE_UNCHANGED){
+				err = NO_WRITE_ERR;
+			}
+			nfc->schedulerNFCWriteWait = TRUE;
+			//wait for write cycle before next read
+			while(nfc->schedulerNFCWriteWait == TRUE){
+				if(whileWaiting != 0){
+					whileWaiting();
+				}
+			}
+		}
+	}
+	return err;
+}
+
+/*=======================================================================================
+Method name:  NFC_bufferWrite()
+
+Originator:   
+
+Description: Takes length bytes of a Modbus write to the NFC from address into the
+			 write back pages in RAM, nothing goes over I2C. Bytes of a page already
+			 pending are merged into it, so repeated and adjacent writes to a page cost
+			 one write cycle when NFC_writeBackFlush() runs. Cached lines are updated
+			 so reads return the new data. Returns NFC_WRITE_FULL, and takes nothing,
+			 if there are not enough free pages for the write.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Drops the broadcast fingerprint
+---------------------------------------------------------------------------------------*/
+uint8_t NFC_bufferWrite(uint16_t address, uint8_t *pData, uint8_t length) {
+	uint16_t page;
+	uint16_t lastPage;
+	uint8_t needed = 0;
+	uint8_t i;
+	uint8_t slot = 0;
+	uint8_t line = NFC_CACHE_LINES;
+	uint8_t offset;
+
+	lastPage = (address + length - 1) / BYTES_IN_PAGE;
+	for(page = address / BYTES_IN_PAGE; page <= lastPage; page++){
+		if(NFC_findDirtyPagePRIV(page + 1) == NFC_WRITE_BACK_PAGES){
+			needed++;
+		}
+	}
+	if(needed > (NFC_WRITE_BACK_PAGES - dirtyPages)){
+		return NFC_WRITE_FULL;
+	}
+	if(dirtyPages == 0){
+		writeBackAgeMsec = 0;
+	}
+	writeBackIdleMsec = 0;
+	NFC_fingerprintInvalidatePRIV(address, length);
+	for(i = 0; i < length; i++, address++){
+		offset = address % BYTES_IN_PAGE;
+		if(i == 0 || offset == 0){//next page
+			page = (address / BYTES_IN_PAGE) + 1;
+			slot = NFC_findDirtyPagePRIV(page);
+			if(slot == NFC_WRITE_BACK_PAGES){
+				slot = NFC_findDirtyPagePRIV(0);
+				dirtyPage[slot].page = page;
+				dirtyPage[slot].mask = 0;
+				dirtyPages++;
+			}
+		}
+		dirtyPage[slot].data[offset] = pData[i];
+		dirtyPage[slot].mask |= (uint8_t)(1 << offset);
+		if(i == 0 || (address % NFC_CACHE_LINE_SIZE) == 0){//next line
+			line = NFC_cacheFindPRIV(address);
+		}
+		if(line < NFC_CACHE_LINES){
+			cacheData[line][address % NFC_CACHE_LINE_SIZE] = pData[i];
+		}
+	}
+	return NO_WRITE_ERR;
+}
+
+/*=======================================================================================
+Method name:  NFC_writeBackDue()
+
+Originator:   
+
+Description: Called every 1 msec from Scheduler_manageTasks(), ages the write back
+			 pages and returns TRUE when they should be written with
+			 NFC_writeBackFlush(): no write for NFC_WRITE_BACK_IDLE_MSEC, the oldest
+			 pending for NFC_WRITE_BACK_MAX_MSEC, NFC_WRITE_BACK_HIGH_WATER pages
+			 pending or a write taken into an NFC_POLICY_IMMEDIATE region.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Due at once after an NFC_POLICY_IMMEDIATE write
+---------------------------------------------------------------------------------------*/
+bool NFC_writeBackDue(void) {
+	if(dirtyPages == 0){
+		writeBackNow = FALSE;	//write was not taken into the pages
+		return FALSE;
+	}
+	if(writeBackNow){
+		return TRUE;
+	}
+	if(writeBackIdleMsec < NFC_WRITE_BACK_IDLE_MSEC){
+		writeBackIdleMsec++;
+	}
+	if(writeBackAgeMsec < NFC_WRITE_BACK_MAX_MSEC){
+		writeBackAgeMsec++;
+	}
+	return (writeBackIdleMsec >= NFC_WRITE_BACK_IDLE_MSEC || writeBackAgeMsec >= NFC_WRITE_BACK_MAX_MSEC ||
+			dirtyPages >= NFC_WRITE_BACK_HIGH_WATER);
+}
+
+/*=======================================================================================
+Method name:  NFC_writeBackFlush()
+
+Originator:   
+
+Description: Writes the write back pages to the NFC in address order. Each page is read
+			 from the NFC, merged with the bytes written and only written if it is
+			 different. The page is freed before it is written, after a page write it
+			 waits for the write cycle like NFC_compareWrite() and calls whileWaiting
+			 meanwhile if it is not 0. Returns NFC_WRITE_ERR if a page write was not
+			 acknowledged, the pages are dropped either way.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Clears the NFC_POLICY_IMMEDIATE request
+1.02    10-16-2026   Page read passed to NFC_pageWritePRIV()
+---------------------------------------------------------------------------------------*/
+uint8_t NFC_writeBackFlush(NFC_STYP *nfc, void (*whileWaiting)(void)) {
+	uint8_t count;
+	uint8_t i;
+	uint8_t j;
+	uint8_t slot;
+	uint8_t same;
+	uint16_t address;
+	uint8_t err = NO_WRITE_ERR;
+	uint8_t old[BYTES_IN_PAGE];
+	uint8_t data[BYTES_IN_PAGE];
+
+	writeBackNow = FALSE;	//writes taken while waiting set it again
+	for(count = dirtyPages; count > 0; count--){
+		slot = NFC_WRITE_BACK_PAGES;
+		for(i = 0; i < NFC_WRITE_BACK_PAGES; i++){//lowest page first
+			if(dirtyPage[i].page != 0 && (slot == NFC_WRITE_BACK_PAGES || dirtyPage[i].page < dirtyPage[slot].page)){
+				slot = i;
+			}
+		}
+		address = (dirtyPage[slot].page - 1) * BYTES_IN_PAGE;
+		NFC_readDevicePRIV(address, BYTES_IN_PAGE, old);	//not the cache, it holds the new data
+		same = TRUE;
+		for(j = 0; j < BYTES_IN_PAGE; j++){
+			data[j] = old[j];
+			if((dirtyPage[slot].mask & (1 << j)) && old[j] != dirtyPage[slot].data[j]){
+				data[j] = dirtyPage[slot].data[j];
+				same = FALSE;
+			}
+		}
+		dirtyPage[slot].page = 0;
+		dirtyPages--;
+		if(!same){
+			if(NFC_pageWritePRIV(address, old, data) != NO_WRITE_ERR){
+				err = NFC_WRITE_ERR;
+			}
+			nfc->schedulerNFCWriteWait = TRUE;
+			//wait for write cycle before next read
+			while(nfc->schedulerNFCWriteWait == TRUE){
+				if(whileWaiting != 0){
+					whileWaiting();
+				}
+			}
+		}
+	}
+	return err;
+}
+
+/*=======================================================================================
+Method name:  NFC_writeAllowed()
+
+Originator:   
+
+Description: Called before a Modbus write of length bytes from address is taken, with
+			 the region write policies set in MIN_SLAVE_REGION0_POLICY_RNUM on. Returns
+			 FALSE if a region written is NFC_POLICY_RATE_LIMITED and has had its
+			 writes for this interval, the master is answered busy and a broadcast
+			 dropped. Counts nothing, see NFC_countWrite().
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Renamed from NFC_takeWrite(), counting moved to NFC_countWrite()
+---------------------------------------------------------------------------------------*/
+bool NFC_writeAllowed(uint16_t address, uint16_t length) {
+	uint8_t i;
+	uint16_t policy;
+	uint16_t end = address + length;
+
+	for(i = 0; i < NFC_POLICY_REGIONS; i++){
+		policy = oMinSlave.slaveRegisters[MIN_SLAVE_REGION0_POLICY_RNUM + i];
+		if(address < nfcRegionTable[i].end && end > nfcRegionTable[i].start &&
+		   (policy >> NFC_POLICY_SHIFT) == NFC_POLICY_RATE_LIMITED && policyWrites[i] >= (policy & LSB_MASK)){
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*=======================================================================================
+Method name:  NFC_countWrite()
+
+Originator:   
+
+Description: Called once a Modbus write allowed by NFC_writeAllowed() has been taken,
+			 into the write back pages, written or flagged for the Scheduler. Counts
+			 the write in each region written and flushes the write back pages at
+			 once if a region is NFC_POLICY_IMMEDIATE. A write refused busy after the
+			 check is not counted.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+void NFC_countWrite(uint16_t address, uint16_t length) {
+	uint8_t i;
+	uint16_t policy;
+	uint16_t end = address + length;
+
+	for(i = 0; i < NFC_POLICY_REGIONS; i++){
+		policy = oMinSlave.slaveRegisters[MIN_SLAVE_REGION0_POLICY_RNUM + i];
+		if(address < nfcRegionTable[i].end && end > nfcRegionTable[i].start){
+			if(policyWrites[i] < 0xFF){
+				policyWrites[i]++;
+			}
+			if((policy >> NFC_POLICY_SHIFT) == NFC_POLICY_IMMEDIATE){
+				writeBackNow = TRUE;
+			}
+		}
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_policyTick()
+
+Originator:   
+
+Description: Called every minute from Scheduler_serviceNFCWrite(), starts a new
+			 NFC_POLICY_RATE_LIMITED interval every MIN_SLAVE_POLICY_INTERVAL_RNUM
+			 minutes (0 is 1 minute).
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+void NFC_policyTick(void) {
+	uint8_t i;
+
+	policyMinutes++;
+	if(policyMinutes >= oMinSlave.slaveRegisters[MIN_SLAVE_POLICY_INTERVAL_RNUM]){
+		policyMinutes = 0;
+		for(i = 0; i < NFC_POLICY_REGIONS; i++){
+			policyWrites[i] = 0;
+		}
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_savePolicy()
+
+Originator:   
+
+Description: Saves NFC_POLICY_MARKER, the interval and the region policy registers
+			 to the NFC at NFC_POLICY_OFFSET through the write back pages, only the
+			 words that changed cost a write cycle. Returns NFC_WRITE_FULL if the
+			 write back pages have no room.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+uint8_t NFC_savePolicy(void) {
+	uint8_t i;
+	uint16_t word;
+	uint8_t data[NFC_POLICY_SIZE];
+
+	for(i = 0; i < (NFC_POLICY_SIZE / 2); i++){
+		word = (i == 0) ? NFC_POLICY_MARKER : oMinSlave.slaveRegisters[MIN_SLAVE_POLICY_INTERVAL_RNUM + i - 1];
+		data[i * 2] = (uint8_t)(word >> MSB_MASK);
+		data[(i * 2) + 1] = (uint8_t)(word & LSB_MASK);
+	}
+	return NFC_bufferWrite(NFC_POLICY_OFFSET, data, NFC_POLICY_SIZE);
+}
+
+/*=======================================================================================
+Method name:  NFC_broadcastUnchanged()
+
+Originator:   
+
+Description: Returns TRUE if the NFC already holds this broadcast block: a block of
+			 the same address and length was stored by NFC_broadcastStored() with the
+			 same CRC-16 and none of its bytes were written since. The master sends
+			 the same blocks over and over, these are dropped without reading the NFC.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+bool NFC_broadcastUnchanged(uint16_t address, uint8_t *pData, uint8_t length) {
+	uint8_t i;
+
+	for(i = 0; i < NFC_FINGERPRINTS; i++){
+		if(fingerprint[i].length == length && fingerprint[i].address == address){
+			return (fingerprint[i].crc == NFC_fingerprintCrcPRIV(pData, length));
+		}
+	}
+	return FALSE;
+}
+
+/*=======================================================================================
+Method name:  NFC_broadcastStored()
+
+Originator:   
+
+Description: Called after a broadcast block was written to the NFC without error,
+			 remembers its address, length and CRC-16 for NFC_broadcastUnchanged().
+			 A block at a new address takes a free entry, or the entries are reused
+			 in turn.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+void NFC_broadcastStored(uint16_t address, uint8_t *pData, uint8_t length) {
+	uint8_t i;
+	uint8_t entry = NFC_FINGERPRINTS;
+
+	for(i = 0; i < NFC_FINGERPRINTS; i++){
+		if(fingerprint[i].length == length && fingerprint[i].address == address){
+			entry = i;
+			break;
+		}
+		if(fingerprint[i].length == 0 && entry == NFC_FINGERPRINTS){
+			entry = i;
+		}
+	}
+	if(entry == NFC_FINGERPRINTS){
+		entry = fingerprintNext;
+		fingerprintNext = (uint8_t)((fingerprintNext + 1) % NFC_FINGERPRINTS);
+	}
+	fingerprint[entry].address = address;
+	fingerprint[entry].length = length;
+	fingerprint[entry].crc = NFC_fingerprintCrcPRIV(pData, length);
+}
+
+/*=======================================================================================
+Method name:  NFC_digestUpdate()
+
+Originator:   
+
+Description: Called every pass of the main loop. Computes the CRC-16 (Modbus) of each
+			 region of nfcRegionTable[] whose digest is not known, at power up or
+			 after a failed page write, into MIN_SLAVE_REGION0_DIGEST_RNUM + region.
+			 Reads one cache line of the NFC per call, not through the cache, and
+			 nothing while an NFC write is pending. Once computed a digest is kept
+			 up to date by NFC_pageWritePRIV(), it is of what the NFC holds, writes
+			 still in the write back pages are not in it, see NFC_digestReady().
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+void NFC_digestUpdate(NFC_STYP *nfc) {
+	uint8_t i;
+	uint8_t length;
+	uint16_t *pDigest;
+	uint8_t data[NFC_CACHE_LINE_SIZE];
+
+	if(digestStale == 0 || NFC_isBusy(nfc)){
+		return;
+	}
+	if((digestStale & (1 << digestRegion)) == 0){//next region
+		for(digestRegion = 0; (digestStale & (1 << digestRegion)) == 0; digestRegion++){
+		}
+		digestAddress = nfcRegionTable[digestRegion].start;
+	}
+	pDigest = &oMinSlave.slaveRegisters[MIN_SLAVE_REGION0_DIGEST_RNUM + digestRegion];
+	if(digestAddress == nfcRegionTable[digestRegion].start){
+		*pDigest = 0xFFFF;
+	}
+	length = NFC_CACHE_LINE_SIZE;
+	if(length > nfcRegionTable[digestRegion].end - digestAddress){
+		length = (uint8_t)(nfcRegionTable[digestRegion].end - digestAddress);
+	}
+	NFC_readDevicePRIV(digestAddress, length, data);
+	for(i = 0; i < length; i++){
+		*pDigest = update_crc_16(*pDigest, data[i]);
+	}
+	digestAddress = digestAddress + length;
+	if(digestAddress >= nfcRegionTable[digestRegion].end){
+		digestStale &= (uint8_t)~(1 << digestRegion);
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_digestReady()
+
+Originator:   
+
+Description: Returns TRUE when the digest of region (index of nfcRegionTable[]) has
+			 been computed by NFC_digestUpdate() and no write to the region is
+			 pending, in the write back pages or flagged for the Scheduler. A master
+			 that writes and then reads the digest is answered busy until the
+			 digest holds its write.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Not ready while a write to the region is pending
+---------------------------------------------------------------------------------------*/
+bool NFC_digestReady(NFC_STYP *nfc, uint8_t region) {
+	uint8_t i;
+
+	if(digestStale & (1 << region)){
+		return FALSE;
+	}
+	for(i = 0; i < NFC_WRITE_BACK_PAGES && dirtyPages != 0; i++){
+		if(dirtyPage[i].page != 0 &&
+		   NFC_inRegionPRIV(region, (dirtyPage[i].page - 1) * BYTES_IN_PAGE, BYTES_IN_PAGE)){
+			return FALSE;
+		}
+	}
+	if((nfc->instantWriteFLG && NFC_inRegionPRIV(region, NFC_getUpdateBlkAddress(nfc), nfc->update.length)) ||
+	   (nfc->storeBroadcastFLG && NFC_inRegionPRIV(region, NFC_getBroadcastBlkAddress(nfc), nfc->broadcast.length)) ||
+	   (nfc->productInfoFLG && NFC_inRegionPRIV(region, BLOCK_NVM_OFFSET, nfc->productInfoLength))){
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*=======================================================================================
+Method name:  NFC_findDirtyPagePRIV()
+
+Originator:   
+
+Description: Returns the write back slot holding page (NFC page number + 1), or the
+			 first free slot for page 0. NFC_WRITE_BACK_PAGES if there is none.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static uint8_t NFC_findDirtyPagePRIV(uint16_t page) {
+	uint8_t i;
+
+	for(i = 0; i < NFC_WRITE_BACK_PAGES; i++){
+		if(dirtyPage[i].page == page){
+			break;
+		}
+	}
+	return i;
+}
+
+/*=======================================================================================
+Method name:  NFC_overlayDirtyPRIV()
+
+Originator:   
+
+Description: Copies the write back bytes from address up to address + length over
+			 data read from the NFC, or with newer is TRUE copies data over the write
+			 back bytes so a pending page does not undo a newer write.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static void NFC_overlayDirtyPRIV(uint16_t address, uint8_t *data, uint16_t length, bool newer) {
+	uint8_t i;
+	uint8_t j;
+	uint16_t byteAddress;
+
+	for(i = 0; i < NFC_WRITE_BACK_PAGES && dirtyPages != 0; i++){
+		if(dirtyPage[i].page == 0){
+			continue;
+		}
+		byteAddress = (dirtyPage[i].page - 1) * BYTES_IN_PAGE;
+		for(j = 0; j < BYTES_IN_PAGE; j++, byteAddress++){
+			if((dirtyPage[i].mask & (1 << j)) && byteAddress >= address && byteAddress < address + length){
+				if(newer){
+					dirtyPage[i].data[j] = data[byteAddress - address];
+				}
+				else{
+					data[byteAddress - address] = dirtyPage[i].data[j];
+				}
+			}
+		}
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_loadPolicyPRIV()
+
+Originator:   
+
+Description: Copies the write policies saved by NFC_savePolicy() to the slave
+			 registers. Nothing is copied if NFC_POLICY_MARKER is not there, the
+			 registers keep their defaults. A region with an unknown policy gets
+			 NFC_POLICY_ON_CHANGE.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static void NFC_loadPolicyPRIV(void) {
+	uint8_t i;
+	uint16_t word;
+	uint8_t data[NFC_POLICY_SIZE];
+
+	NFC_SequentialRead(NFC_POLICY_OFFSET, NFC_POLICY_SIZE, data);
+	if((((uint16_t)data[0] << MSB_MASK) | data[1]) != NFC_POLICY_MARKER){
+		return;
+	}
+	for(i = 1; i < (NFC_POLICY_SIZE / 2); i++){
+		word = ((uint16_t)data[i * 2] << MSB_MASK) | data[(i * 2) + 1];
+		if(i > 1 && (word >> NFC_POLICY_SHIFT) >= NFC_POLICIES){
+			word = NFC_POLICY_ON_CHANGE << NFC_POLICY_SHIFT;
+		}
+		oMinSlave.slaveRegisters[MIN_SLAVE_POLICY_INTERVAL_RNUM + i - 1] = word;
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_fingerprintCrcPRIV()
+
+Originator:   
+
+Description: Returns the CRC-16 of length bytes from pData, same CRC as Modbus.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static uint16_t NFC_fingerprintCrcPRIV(uint8_t *pData, uint8_t length) {
+	uint16_t crc = 0xFFFF;
+
+	while(length--){
+		crc = update_crc_16(crc, *pData++);
+	}
+	return crc;
+}
+
+/*=======================================================================================
+Method name:  NFC_fingerprintInvalidatePRIV()
+
+Originator:   
+
+Description: Drops the broadcast fingerprints of blocks holding any byte from address
+			 up to address + length, called when this firmware writes the NFC or takes
+			 a write into the write back pages.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static void NFC_fingerprintInvalidatePRIV(uint16_t address, uint16_t length) {
+	uint8_t i;
+
+	for(i = 0; i < NFC_FINGERPRINTS; i++){
+		if(fingerprint[i].length != 0 && address < (fingerprint[i].address + fingerprint[i].length) &&
+		   (address + length) > fingerprint[i].address){
+			fingerprint[i].length = 0;
+		}
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_regionPRIV()
+
+Originator:   
+
+Description: Returns the index of the nfcRegionTable[] region holding address.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static uint8_t NFC_regionPRIV(uint16_t address) {
+	uint8_t i;
+
+	for(i = 0; i < (NFC_REGIONS - 1); i++){
+		if(address < nfcRegionTable[i].end){
+			break;
+		}
+	}
+	return i;
+}
+
+/*=======================================================================================
+Method name:  NFC_digestPagePRIV()
+
+Originator:   
+
+Description: Updates the digest of the region holding the page at address after the
+			 page was written, old is the page before and data after. The CRC is
+			 linear, so the digest changes by the CRC, from 0, of the bytes that
+			 changed (old XOR data) followed by a zero byte for each byte of the
+			 region after the page. Costs nothing if the page did not change and one
+			 CRC step per byte up to the end of the region if it did. While the
+			 digest is being computed only the bytes already read are corrected.
+			 Data written from an address that is not page aligned can cross a
+			 region end, each part then corrects the digest of its own region.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+1.01    10-16-2026   Page split at region end and digest read position
+---------------------------------------------------------------------------------------*/
+static void NFC_digestPagePRIV(uint16_t address, uint8_t *old, uint8_t *data) {
+	uint8_t j = 0;
+	uint8_t region;
+	uint16_t end;
+	uint16_t next;
+	uint16_t crc;
+
+	while(j < BYTES_IN_PAGE){
+		region = NFC_regionPRIV(address + j);
+		end = nfcRegionTable[region].end;
+		if(address + j >= end){
+			return;		//past the end of NFC memory
+		}
+		if(digestStale & (1 << region)){
+			//new data is read when the digest is computed, only bytes read are corrected
+			end = (region == digestRegion) ? digestAddress : nfcRegionTable[region].start;
+		}
+		crc = 0;
+		next = end;		//after the last byte in crc
+		for(; j < BYTES_IN_PAGE && address + j < nfcRegionTable[region].end; j++){
+			if(address + j < end){
+				crc = update_crc_16(crc, old[j] ^ data[j]);
+				next = address + j + 1;
+			}
+		}
+		if(crc != 0){	//part of the page in region changed
+			for(next = end - next; next > 0; next--){
+				crc = update_crc_16(crc, 0);
+			}
+			oMinSlave.slaveRegisters[MIN_SLAVE_REGION0_DIGEST_RNUM + region] ^= crc;
+		}
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_digestStalePRIV()
+
+Originator:   
+
+Description: Marks the digest of region as not known, NFC_digestUpdate() computes it
+			 again from the start of the region.
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static void NFC_digestStalePRIV(uint8_t region) {
+	digestStale |= (uint8_t)(1 << region);
+	if(region == digestRegion){
+		digestAddress = nfcRegionTable[region].start;
+	}
+}
+
+/*=======================================================================================
+Method name:  NFC_inRegionPRIV()
+
+Originator:   
+
+Description: Returns TRUE when any of length bytes from address is in region (index
+			 of nfcRegionTable[]).
+=======================================================================================
+History:
+ *-------*-----------*---------------------------------------------------*--------------
+1.00    10-16-2026   Original code
+---------------------------------------------------------------------------------------*/
+static bool NFC_inRegionPRIV(uint8_t region, uint16_t address, uint16_t length) {
+	return (address < nfcRegionTable[region].end && (address + length) > nfcRegionTable[region].start);
+}
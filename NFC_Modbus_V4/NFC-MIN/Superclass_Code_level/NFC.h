@@ -17,6 +17,25 @@ NFC_ReadByte(uint16_t address);							//Called from Scheduler.c and MinSlave.c
 NFC_CurrentRead();				
 NFC_Write(NFC_STYP *nfc);								//Called from Scheduler.c
 NFC_Read(NFC_STYP *nfc);								//Called from Scheduler.c
+NFC_isBusy(NFC_STYP *nfc);								//Called from MinSlave.c
+NFC_isWriting(nfc);										//Called from MinSlave.c
+NFC_pendingByte(nfc, address, data);					//Called from MinSlave.c
+NFC_overlayPending(nfc, address, pData, length);		//Called from MinSlave.c
+NFC_checkAccess(address, length, access);				//Called from MinSlave.c
+NFC_compareWrite(nfc, address, pData, length, whileWaiting);	//Called from Scheduler.c and MinSlave.c
+NFC_StreamRead(address, length, byteRead);				//Called from MinSlave.c
+NFC_prefetch(nfc);										//Called from MyMain.c every pass of the main loop
+NFC_bufferWrite(address, pData, length);				//Called from MinSlave.c
+NFC_writeBackDue();										//Called from Scheduler.c every 1 msec
+NFC_writeBackFlush(nfc, whileWaiting);					//Called from Scheduler.c
+NFC_writeAllowed(address, length);						//Called from MinSlave.c before each Modbus write
+NFC_countWrite(address, length);						//Called from MinSlave.c once the write is taken
+NFC_policyTick();										//Called from Scheduler.c every minute
+NFC_savePolicy();										//Called from MinSlave.c
+NFC_broadcastUnchanged(address, pData, length);		//Called from MinSlave.c
+NFC_broadcastStored(address, pData, length);			//Called from Scheduler.c
+NFC_digestUpdate(nfc);									//Called from MyMain.c every pass of the main loop
+NFC_digestReady(nfc, region);							//Called from MinSlave.c
 Peripheral Resources:
 Assume as UART is available for 19,200 up to 115,200 baud
 
@@ -46,6 +65,29 @@ Other requirements:
 1.09	05-10-2021	Updated the NFC_CONFIG_CODE_MSB & LSB address	 Anish Venkataraman
 					added productInfoData and length to the class
 					structure and updated the defaults for the same.
+1.10	10-16-2026	nfcBuffer and productInfoData replaced by pointers
+					into the Modbus frame buffer, no copy of the data
+1.11	10-16-2026	Added NFC_isBusy()
+1.12	10-16-2026	Added NFC_MEM_SIZE, NFCRegion_STYP memory map and
+					NFC_checkAccess()
+1.13	10-16-2026	Added NFC_compareWrite()
+1.14	10-16-2026	Added NFC_EVENT_LOG_OFFSET, NFC_PageWrite() and
+					NFC_compareWrite() return write error
+1.15	10-16-2026	Added NFC_StreamRead()
+1.16	10-16-2026	Added NFC_CACHE_LINE_SIZE and NFC_CACHE_LINES read cache
+1.17	10-16-2026	Added NFC_prefetch() and NFC_PREFETCH_LINES
+1.18	10-16-2026	Added NFCDirtyPage_STYP write back pages, NFC_bufferWrite(),
+					NFC_writeBackDue(), NFC_writeBackFlush() and NFC_WRITE_FULL
+1.19	10-16-2026	Added NFC_isWriting(), NFC_pendingByte() and NFC_overlayPending()
+1.20	10-16-2026	Added per region write policies, NFC_POLICY_OFFSET,
+					NFC_takeWrite(), NFC_policyTick() and NFC_savePolicy()
+1.21	10-16-2026	Added NFCFingerprint_STYP broadcast fingerprints,
+					NFC_broadcastUnchanged() and NFC_broadcastStored()
+1.22	10-16-2026	Added NFC_REGIONS region digests, NFC_digestUpdate() and
+					NFC_digestReady()
+1.23	10-16-2026	NFC_takeWrite() split into NFC_writeAllowed() and NFC_countWrite()
+1.24	10-16-2026	NFC_digestReady() takes the NFC object
+1.25	10-16-2026	Added NFC_WRITE_UNCHANGED
  ---------------------------------------------------------------------------------------
  */
 
@@ -69,29 +111,69 @@ Other requirements:
 #define NFC_CONFIG_CODE_MSB		0x099	//MSB byte of config code
 #define NFC_CONFIG_CODE_LSB		0x098	//LSB byte of config code
 #define NFC_MAX_MEM				256	    //Max Memory
+#define NFC_MEM_SIZE			0x800	//ST25DV16K user memory, 2 Kbytes
+#define NFC_POLICY_OFFSET		0x6F0	//Write policies saved by NFC_savePolicy(), up to NFC_EVENT_LOG_OFFSET
+#define NFC_EVENT_LOG_OFFSET	0x700	//Event log ring up to NFC_MEM_SIZE, see EventLog.h
 #define NFC_WRITE_TIME			5	    //5ms per write cycle
 #define MSB_MASK 8
 #define LSB_MASK 0xFF
 #define MAX_INSTANT_WRITE_BYTES 8
 #define BYTES_IN_PAGE			4
+#define NFC_CACHE_LINE_SIZE		16		//Bytes per read cache line, 4 pages, power of 2
+#define NFC_CACHE_LINES			8		//Read cache lines, 128 bytes of RAM, at most 8 (one reference bit each)
+#define NFC_PREFETCH_LINES		4		//Most lines read ahead of an ascending scan, rest of cache kept for polls
+#define NFC_WRITE_BACK_PAGES	8		//Pages of Modbus writes held in RAM, see NFC_bufferWrite()
+#define NFC_WRITE_BACK_HIGH_WATER	4	//Pages pending that start a flush
+#define NFC_WRITE_BACK_IDLE_MSEC	20	//Flush after no write for this long
+#define NFC_WRITE_BACK_MAX_MSEC		1000	//Flush when the oldest write has waited this long
+#define NFC_POLICY_REGIONS		5		//First regions of nfcRegionTable[] with a write policy
+#define NFC_POLICY_SHIFT		8		//Policy register: policy in high byte, writes per interval in low byte
+#define NFC_POLICY_MARKER		0x5A5A	//First word of saved policies, anything else is not saved
+#define NFC_POLICY_SIZE			((2 + NFC_POLICY_REGIONS) * 2)	//Marker, interval and region policy words
+#define NFC_FINGERPRINTS		4		//Broadcast blocks remembered, see NFC_broadcastStored()
 
 
-#define BLK_DEFAULTS	{0,0,0,{0}}
+#define BLK_DEFAULTS	{0,0,0,((void*)0)}
 #define NFC_DEFAULTS				\
 		{FALSE,FALSE,FALSE,FALSE,	\
 		FALSE,FALSE,				\
 		FALSE,						\
 		UNKNOWN_WATER_HEATER,		\
-		0,{0},						\
+		0,((void*)0),				\
 		BLK_DEFAULTS,BLK_DEFAULTS}			
 
 
+//Memory map region, see nfcRegionTable[] in NFC.c
+#define NFC_REGIONS				7		//Entries of nfcRegionTable[], at most 8 (one digest bit each)
+#define NFC_REGION_READ			0x01	//Modbus read allowed
+#define NFC_REGION_WRITE		0x02	//Modbus write allowed
+
+typedef struct{
+	uint16_t start;				//First byte address
+	uint16_t end;				//Byte address after the region
+	uint8_t access;				//NFC_REGION_READ and/or NFC_REGION_WRITE
+}NFCRegion_STYP;
+
+//Write back page, see NFC_bufferWrite() in NFC.c
+typedef struct{
+	uint16_t page;				//NFC page number + 1, 0 = free
+	uint8_t mask;				//Bit per byte of data[] written
+	uint8_t data[BYTES_IN_PAGE];
+}NFCDirtyPage_STYP;
+
+//Broadcast block the NFC holds, see NFC_broadcastUnchanged() in NFC.c
+typedef struct{
+	uint16_t address;			//NFC byte address of the block
+	uint8_t length;				//Bytes in the block, 0 = free
+	uint16_t crc;				//CRC-16 of the block data
+}NFCFingerprint_STYP;
+
 //Class Structure
 typedef struct{
 	uint8_t blockNumber;
 	uint16_t registerNumber;
 	uint8_t length;
-	uint8_t nfcBuffer[NFC_MAX_MEM];
+	uint8_t *pNfcData;			//Points into MinUart frame slot, see MinSlave_releaseFrame()
 }block_STYP;
 
 typedef struct{
@@ -104,7 +186,7 @@ typedef struct{
 	volatile bool schedulerNFCWriteWait;	//Set every 5ms
 	uint16_t configuration;
 	uint16_t productInfoLength;
-	uint8_t productInfoData[NFC_MAX_MEM];
+	uint8_t *pProductInfoData;	//Points into MinUart frame slot, see MinSlave_releaseFrame()
 	block_STYP broadcast;
 	block_STYP update;
 }NFC_STYP;
@@ -117,9 +199,28 @@ uint8_t NFC_CurrentRead(void);
 byte NFC_Write(NFC_STYP *nfc);
 void NFC_init(NFC_STYP *nfc);
 void NFC_SequentialRead(uint16_t address, uint8_t length,uint8_t *data);
+void NFC_StreamRead(uint16_t address, uint8_t length, void (*byteRead)(uint8_t data));
 uint16_t NFC_getUpdateBlkAddress(NFC_STYP *nfc);
 uint16_t NFC_getBroadcastBlkAddress(NFC_STYP *nfc);
-void NFC_PageWrite(uint16_t address, uint8_t *data);
+uint8_t NFC_PageWrite(uint16_t address, uint8_t *data);
+bool NFC_isBusy(NFC_STYP *nfc);
+bool NFC_isWriting(NFC_STYP *nfc);
+uint8_t NFC_pendingByte(NFC_STYP *nfc, uint16_t address, uint8_t data);
+void NFC_overlayPending(NFC_STYP *nfc, uint16_t address, uint8_t *pData, uint8_t length);
+void NFC_prefetch(NFC_STYP *nfc);
+uint8_t NFC_bufferWrite(uint16_t address, uint8_t *pData, uint8_t length);
+bool NFC_writeBackDue(void);
+uint8_t NFC_writeBackFlush(NFC_STYP *nfc, void (*whileWaiting)(void));
+bool NFC_writeAllowed(uint16_t address, uint16_t length);
+void NFC_countWrite(uint16_t address, uint16_t length);
+void NFC_policyTick(void);
+uint8_t NFC_savePolicy(void);
+bool NFC_broadcastUnchanged(uint16_t address, uint8_t *pData, uint8_t length);
+void NFC_broadcastStored(uint16_t address, uint8_t *pData, uint8_t length);
+void NFC_digestUpdate(NFC_STYP *nfc);
+bool NFC_digestReady(NFC_STYP *nfc, uint8_t region);
+bool NFC_checkAccess(uint16_t address, uint16_t length, uint8_t access);
+uint8_t NFC_compareWrite(NFC_STYP *nfc, uint16_t address, uint8_t *pData, uint16_t length, void (*whileWaiting)(void));
 //Status
 enum{
 	NFC_IDLE_STATE = 0,
@@ -133,6 +234,17 @@ enum{
 enum{
 	NO_WRITE_ERR = 0,
 	NFC_WRITE_ERR,
+	NFC_WRITE_FULL,				//No free write back page, see NFC_bufferWrite()
+	NFC_WRITE_UNCHANGED,		//NFC already held the data, no page written, see NFC_compareWrite()
+};
+
+//Region write policy, high byte of MIN_SLAVE_REGION0_POLICY_RNUM on
+enum{
+	NFC_POLICY_ON_CHANGE = 0,	//Held in the write back pages, pages that did not change are not written (default)
+	NFC_POLICY_IMMEDIATE,		//Write back pages written as soon as the write is taken
+	NFC_POLICY_RATE_LIMITED,	//Writes per interval in the low byte, more are refused (busy)
+	NFC_POLICY_READ_ONLY,		//Modbus writes refused (illegal address)
+	NFC_POLICIES
 };
 
 //Error Read
@@ -13,6 +13,10 @@ Originator:   Tom Van Sistine
 1.01	11-04-2019	Adapted from CPAM code							 Anish Venkataraman
 1.02	11-05-2019	Changed scheduling from 5msec to 1min			 Anish Venkataraman
 1.03	08-12-2020	Added check in MyMain_run() to write to NFC		 Anish Venkataraman
+1.04	10-16-2026	MyMain_main() 1.05
+1.05	10-16-2026	MyMain_systemInit() 1.02, added oEventLog
+1.06	10-16-2026	MyMain_main() 1.06
+1.07	10-16-2026	MyMain_main() 1.07
 ---------------------------------------------------------------------------------------
 */
 
@@ -22,11 +26,13 @@ Originator:   Tom Van Sistine
 #include "Scheduler.h"
 #include "LedCtrl.h"
 #include "NFC.h"
+#include "EventLog.h"
 
 //------------------ Instantiate all class objects here --------------------------------
 MinSlave_STYP oMinSlave = MIN_DEFAULTS;
 LedCtrl_STYP oLed;
 NFC_STYP oNFC = NFC_DEFAULTS;
+EventLog_STYP oEventLog = EVENT_LOG_DEFAULTS;
 
 // Instantiate itself.
 MyMain_STYP mainObject = MYMAIN_DEFAULTS;
@@ -48,6 +54,7 @@ History:
 *-----*-------------*---------------------------------------------------*--------------
 1.00	11-04-2019	Original Code										Anish Venkataraman
 1.01	11-04-2019	Modified for NFC									Anish Venkataraman
+1.02	10-16-2026	Initialize event log after NFC
 
 ---------------------------------------------------------------------------------------
 */
@@ -56,6 +63,7 @@ void MyMain_systemInit(void){
 	LedCtrl_init(&oLed);
 	MinSlave_init(&oMinSlave);
 	NFC_init(&oNFC);
+	EventLog_init(&oEventLog);
 }
 /*
 =======================================================================================
@@ -71,6 +79,7 @@ Description:
 	go away from a PE project.
 	
 	It monitors the 1 msec timer flag set in driver_isr.c and calls Scheduler_run().  
+	Messages framed by the receive ISR are processed every pass of the loop.
 	
 Resources:
 
@@ -85,6 +94,9 @@ History:
 					added a check for every completion of NFC write.
 1.04	08-12-2020	Check to see if the NFC is permitted to save the Anish Venkataraman
 					data
+1.05	10-16-2026	Process Modbus messages from main loop
+1.06	10-16-2026	Read ahead NFC scans between messages
+1.07	10-16-2026	Compute NFC region digests between messages
 ---------------------------------------------------------------------------------------
 */
 void MyMain_main(void){
@@ -93,6 +105,12 @@ void MyMain_main(void){
 	MyMain_systemInit();
 	while(1)
 	{
+		//Process message received by the USART receive ISR, if any
+		MinSlave_manageMessages();
+		//Read the next window of an ascending register scan into the NFC cache, if any
+		NFC_prefetch(&oNFC);
+		//Compute the NFC region digests not known yet, one line per pass
+		NFC_digestUpdate(&oNFC);
 		//1ms interrupt check
 		if(mainObject.realTimeInterruptFlag == TRUE){			// Set every 1 msec in driver_isr.c
 			mainObject.realTimeInterruptFlag = FALSE;
@@ -21,6 +21,27 @@ Originator:   Tom Van Sistine
 					Scheduler_writeBroadcast(void)
 1.04	08-28-2020	Scheduler_ManageTask() V1.05					 Anish Venkataraman
 1.05	05-10-2021	Scheduler_writeProductInfo() 1.01				 Anish Venkataraman
+1.06	10-16-2026	Scheduler_manageTasks() 1.06, Scheduler_writeProductInfo() 1.02
+					Scheduler_writeInstant() 1.01, Scheduler_writeBroadcast() 1.01
+					Data is written from the Modbus frame buffer which is
+					released when the write is done
+1.07	10-16-2026	Scheduler_writeProductInfo() 1.03, Scheduler_writeInstant() 1.02
+					Scheduler_writeBroadcast() 1.02
+					Modbus messages handled while waiting for NFC page write
+1.08	10-16-2026	Scheduler_writeProductInfo() 1.04, Scheduler_writeInstant() 1.03
+					Scheduler_writeBroadcast() 1.03
+					Page compare and write loop moved to NFC_compareWrite()
+1.09	10-16-2026	Scheduler_manageTasks() 1.07, Scheduler_minTimeoutCheck() 1.01
+					Scheduler_writeProductInfo() 1.05, Scheduler_writeInstant() 1.04
+					Scheduler_writeBroadcast() 1.04
+					Events logged and event log written when no other write
+1.10	10-16-2026	Scheduler_manageTasks() 1.08, NFC write back pages written
+1.11	10-16-2026	Scheduler_serviceNFCWrite() 1.03, NFC write policy interval
+1.12	10-16-2026	Scheduler_writeBroadcast() 1.05, broadcast fingerprint stored
+1.13	10-16-2026	Scheduler_minTimeoutCheck() 1.02, time out logged once after
+					valid communication
+1.14	10-16-2026	Scheduler_manageTasks() 1.09, Scheduler_writeBroadcast() 1.06
+					broadcast logged only when a page was written
 ---------------------------------------------------------------------------------------
 */
 //Includes
@@ -28,16 +49,18 @@ Originator:   Tom Van Sistine
 #include "Scheduler.h"
 #include "MinSlave.h"
 #include "LedCtrl.h"
+#include "EventLog.h"
 
 
 extern MinSlave_STYP oMinSlave;
 extern LedCtrl_STYP oLed;
 extern NFC_STYP oNFC;
+extern EventLog_STYP oEventLog;
 
 //Prototypes
-static void Scheduler_writeProductInfo(void);
-static void Scheduler_writeInstant(void);
-static void Scheduler_writeBroadcast(void);
+static uint8_t Scheduler_writeProductInfo(void);
+static uint8_t Scheduler_writeInstant(void);
+static uint8_t Scheduler_writeBroadcast(void);
 
 /*
 =======================================================================================
@@ -52,6 +75,9 @@ Description:  Called from main() every 1 mSec.
 			   - Scheduler_serviceNFCWrite
 			  CHecks to see if there is a flag set for writing data instantly,productInfo
 			  or if it is a broadcast. Writes the data and then clears the flag;  
+			  Product info stores, broadcasts that changed the NFC and I2C write
+			  errors are added to the event log. With no other write to do the Modbus writes held in
+			  the NFC write back pages are written when due, then the event log.
 	
 Resources:	  
 
@@ -67,26 +93,47 @@ History:
 1.04	08-28-2020  Added call to schedule broadcast block write	 Anish Venkataraman
 1.05	01-08-2021  Added code to save data only when permitted by	 Anish Venkataraman
 					TRC
+1.06	10-16-2026	Release Modbus frame buffer after NFC write
+1.07	10-16-2026	Log stores and write errors, write event log
+1.08	10-16-2026	Write NFC write back pages
+1.09	10-16-2026	Log broadcast only when a page was written
 ---------------------------------------------------------------------------------------
 */
 void Scheduler_manageTasks(void)
 {
 	uint8_t flashCode = 0;
+	uint8_t err;
+	bool writeBackDue;
 	LedCtrl_ledsManager(&oLed,flashCode);
 	Scheduler_minTimeoutCheck();
+	writeBackDue = NFC_writeBackDue();		//every 1 msec, ages the write back pages
 	//only write if the permission to save has been initiated by TRC
 	//if(oMinSlave.slaveRegisters[MIN_SLAVE_PERMIT_TO_SAVE_DATA_RNUM] == INITIALIZED)
 	{
 			if(oNFC.instantWriteFLG == TRUE){//schedule to write block instantly
-				Scheduler_writeInstant();
+				if(Scheduler_writeInstant() == NFC_WRITE_ERR){
+					EventLog_add(&oEventLog, EVENT_LOG_I2C_ERROR, 0);
+				}
 				oNFC.instantWriteFLG = FALSE;
+				MinSlave_releaseFrame();
 			}
 			else if (oNFC.productInfoFLG == TRUE){//schedule to write productInfo block
-				Scheduler_writeProductInfo();
+				err = Scheduler_writeProductInfo();
+				EventLog_add(&oEventLog, EVENT_LOG_PRODUCT_INFO, (uint8_t)oMinSlave.slaveRegisters[MIN_SLAVE_MODEL_CONFIGURATION_CODE]);
+				if(err == NFC_WRITE_ERR){
+					EventLog_add(&oEventLog, EVENT_LOG_I2C_ERROR, EVENT_LOG_PRODUCT_INFO);
+				}
 				oNFC.productInfoFLG = FALSE;
+				MinSlave_releaseFrame();
 			}
 			else if(oNFC.storeBroadcastFLG == TRUE){//schedule to write block broadcast
-				Scheduler_writeBroadcast();
+				err = Scheduler_writeBroadcast();
+				if(err != NFC_WRITE_UNCHANGED){//no entry, and no log write, for a broadcast the NFC held
+					EventLog_add(&oEventLog, EVENT_LOG_BROADCAST, oNFC.broadcast.blockNumber);
+				}
+				if(err == NFC_WRITE_ERR){
+					EventLog_add(&oEventLog, EVENT_LOG_I2C_ERROR, EVENT_LOG_BROADCAST);
+				}
 				if(oNFC.broadcast.blockNumber == BLOCK2 && oNFC.block2WriteFLG == TRUE){
 					oNFC.block2WriteFLG = FALSE;//clear block2 broadcast flag
 				}
@@ -102,6 +149,15 @@ void Scheduler_manageTasks(void)
 					oNFC.block226WriteFLG = FALSE;
 				}
 				oNFC.storeBroadcastFLG = FALSE;
+				MinSlave_releaseFrame();
+			}
+			else if(writeBackDue){//coalesced Modbus writes
+				if(NFC_writeBackFlush(&oNFC, MinSlave_manageMessages) != NO_WRITE_ERR){
+					EventLog_add(&oEventLog, EVENT_LOG_I2C_ERROR, 0);
+				}
+			}
+			else if(EventLog_pending(&oEventLog)){//nothing else to write, store logged events
+				(void)EventLog_flush(&oEventLog, &oNFC, MinSlave_manageMessages);
 			}
 	}
 } 
@@ -114,7 +170,8 @@ void Scheduler_manageTasks(void)
  Description:
  	 	 This routine is called every minute  and checks if there flag for  block is set or 
 		 not. If it is set, it writes the data starting at an offset. Once all data is
-		 written the flag is cleared.
+		 written the flag is cleared. Counts the minutes of the NFC write policy
+		 interval.
 
  Resources:
 
@@ -125,11 +182,13 @@ void Scheduler_manageTasks(void)
  1.01	 11-21-2019  Modified the code to check for errors			   Anish Venkataraman
  1.02	 06-15-2020  Modified the code to support writing of		   Anish Venkataraman
 					 block 11 & 226			  
+ 1.03	 10-16-2026  Call NFC_policyTick()
  ----------------------------------------------------------------------------------------
 */
 
 void Scheduler_serviceNFCWrite(void) {
 	static uint8_t secondCounter = 1;
+	NFC_policyTick();
 	 if (secondCounter == SCHEDULER_BLK2_WRITE) {
 		 oNFC.block2WriteFLG = TRUE;
 	 }
@@ -152,7 +211,9 @@ void Scheduler_serviceNFCWrite(void) {
 
  Description:
  	 	 If MIN timeout timer not zero, decrement.  If then 0 call reset uart to discover
- 	 	 baud rate and reset.
+ 	 	 baud rate and reset. The time out is added to the event log only for the first
+ 	 	 time out after a valid message (validCommunicationReceivedFLG), a silent bus
+ 	 	 is reset every second without filling the log.
 
  Resources:
 
@@ -160,6 +221,8 @@ void Scheduler_serviceNFCWrite(void) {
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    08-02-2019  Original code                                       Tom Van Sistine
+ 1.01    10-16-2026  Log communication time out
+ 1.02    10-16-2026  Log only the first time out after valid communication
  ----------------------------------------------------------------------------------------
  */
 
@@ -167,6 +230,10 @@ void Scheduler_minTimeoutCheck(void){
 	if(oMinSlave.communicationTimeoutCNTR){
 		oMinSlave.communicationTimeoutCNTR--;
 		if(oMinSlave.communicationTimeoutCNTR == 0) {
+			if(oMinSlave.validCommunicationReceivedFLG){
+				oMinSlave.validCommunicationReceivedFLG = FALSE;	//set again by the next valid message
+				EventLog_add(&oEventLog, EVENT_LOG_COMM_TIMEOUT, oMinSlave.uart.baudSelect);
+			}
 			oMinSlave.uart.baudSelect = BR_SELECT_115200;  // Set back to Discovery baud
 			MinSlave_init(&oMinSlave);
 		}
@@ -191,39 +258,16 @@ void Scheduler_minTimeoutCheck(void){
  *-------*-----------*---------------------------------------------------*---------------
  1.00    08-28-2020  Original code                                     Anish Venkataraman	
  1.01    05-10-2021  Restructured code to use NFC_STYP class members   Anish Venkataraman	  
+ 1.02    10-16-2026  Data read from Modbus frame buffer, bytes past end
+					 of data are left as read
+ 1.03    10-16-2026  Handle Modbus messages while waiting for page write
+ 1.04    10-16-2026  Written with NFC_compareWrite()
+ 1.05    10-16-2026  Return write error
  ----------------------------------------------------------------------------------------
 */
-void Scheduler_writeProductInfo(void){
-	uint16_t i = 0;
-	uint8_t count = 0;
-	uint16_t address = 0;
-	uint8_t length = 0;
-	uint8_t data[BYTES_IN_PAGE];
-	uint8_t j = 0;
-	uint8_t index;
-	address = BLOCK_NVM_OFFSET;
-	length = oNFC.productInfoLength;
-	index = 0;
-	for(i = address;i < address+length;){
-		//read data
-		NFC_SequentialRead(i,BYTES_IN_PAGE,data);
-		for(j = 0; j < BYTES_IN_PAGE; j++){
-			//check data if it matches
-			if(data[j] == oNFC.productInfoData[index]){
-				count++;
-			}
-			data[j] = oNFC.productInfoData[index++];
-		}
-		if(count != BYTES_IN_PAGE){
-			NFC_PageWrite(i,data);
-			oNFC.schedulerNFCWriteWait = TRUE;
-			//wait for 5ms before next read
-			while(oNFC.schedulerNFCWriteWait == TRUE);
-		}
-		j = 0;
-		count = 0;
-		i = i + BYTES_IN_PAGE;
-	}
+uint8_t Scheduler_writeProductInfo(void){
+	//Modbus requests are answered while waiting for each page write
+	return NFC_compareWrite(&oNFC, BLOCK_NVM_OFFSET, oNFC.pProductInfoData, oNFC.productInfoLength, MinSlave_manageMessages);
 }
 
 /*
@@ -241,38 +285,16 @@ void Scheduler_writeProductInfo(void){
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    08-28-2020  Original code                                     Anish Venkataraman	  
+ 1.01    10-16-2026  Data read from Modbus frame buffer, bytes past end
+					 of data are left as read
+ 1.02    10-16-2026  Handle Modbus messages while waiting for page write
+ 1.03    10-16-2026  Written with NFC_compareWrite()
+ 1.04    10-16-2026  Return write error
  ----------------------------------------------------------------------------------------
 */
-void Scheduler_writeInstant(void){
-	uint16_t i = 0;
-	uint8_t count = 0;
-	uint16_t address = 0;
-	uint8_t length = 0;
-	uint8_t data[BYTES_IN_PAGE];
-	uint8_t j = 0;
-	uint8_t index;
-	//get address and length of bytes to write
-	address = NFC_getUpdateBlkAddress(&oNFC);
-	length = oNFC.update.length;
-	index = 0;
-	for(i = address;i < address+length;){
-		NFC_SequentialRead(i,BYTES_IN_PAGE,data);
-		for(j = 0; j < BYTES_IN_PAGE; j++){
-			if(data[j] == oNFC.update.nfcBuffer[index]){
-				count++;
-			}
-			data[j] = oNFC.update.nfcBuffer[index++];
-		}
-		if(count != BYTES_IN_PAGE){
-			NFC_PageWrite(i,data);
-			oNFC.schedulerNFCWriteWait = TRUE;
-			//wait for 5ms before next read
-			while(oNFC.schedulerNFCWriteWait == TRUE);
-		}
-		j = 0;
-		count = 0;
-		i = i + BYTES_IN_PAGE;
-	}
+uint8_t Scheduler_writeInstant(void){
+	//get address and length of bytes to write, Modbus requests are answered while waiting for each page write
+	return NFC_compareWrite(&oNFC, NFC_getUpdateBlkAddress(&oNFC), oNFC.update.pNfcData, oNFC.update.length, MinSlave_manageMessages);
 }
 
 /*
@@ -283,7 +305,9 @@ void Scheduler_writeInstant(void){
 
  Description:
  	 	 This routine is called every 1ms  and checks if there flag for broadcast is set or 
-		 not.  Once all data is written the flag is cleared.
+		 not.  Once all data is written the flag is cleared. A block written without
+		 error, or already held, is remembered so the same broadcast is dropped next
+		 time. Returns NFC_WRITE_UNCHANGED if no page was written.
 
  Resources:
 
@@ -291,37 +315,21 @@ void Scheduler_writeInstant(void){
  History:
  *-------*-----------*---------------------------------------------------*---------------
  1.00    08-28-2020  Original code                                     Anish Venkataraman	  
+ 1.01    10-16-2026  Data read from Modbus frame buffer, bytes past end
+					 of data are left as read
+ 1.02    10-16-2026  Handle Modbus messages while waiting for page write
+ 1.03    10-16-2026  Written with NFC_compareWrite()
+ 1.04    10-16-2026  Return write error
+ 1.05    10-16-2026  Store broadcast fingerprint
+ 1.06    10-16-2026  Fingerprint also stored when no page was written
  ----------------------------------------------------------------------------------------
 */
-void Scheduler_writeBroadcast(void){
-	uint16_t i = 0;
-	uint8_t count = 0;
-	uint16_t address = 0;
-	uint8_t length = 0;
-	uint8_t data[BYTES_IN_PAGE];
-	uint8_t j = 0;
-	uint8_t index;
-	//get address and length of bytes to write
-	address = NFC_getBroadcastBlkAddress(&oNFC);
-	length = oNFC.broadcast.length;
-	index = 0;
-	for(i = address;i < address+length;){
-		//Read data before writing
-		NFC_SequentialRead(i,BYTES_IN_PAGE,data);
-		for(j = 0; j < BYTES_IN_PAGE; j++){
-			if(data[j] == oNFC.broadcast.nfcBuffer[index]){
-				count++;
-			}
-			data[j] = oNFC.broadcast.nfcBuffer[index++];
-		}
-		if(count != BYTES_IN_PAGE){//data is different so write the page
-			NFC_PageWrite(i,data);
-			oNFC.schedulerNFCWriteWait = TRUE;
-			//wait for 5ms before next read
-			while(oNFC.schedulerNFCWriteWait == TRUE);
-		}
-		j = 0;
-		count = 0;
-		i = i + BYTES_IN_PAGE;
+uint8_t Scheduler_writeBroadcast(void){
+	uint8_t err;
+	//get address and length of bytes to write, Modbus requests are answered while waiting for each page write
+	err = NFC_compareWrite(&oNFC, NFC_getBroadcastBlkAddress(&oNFC), oNFC.broadcast.pNfcData, oNFC.broadcast.length, MinSlave_manageMessages);
+	if(err != NFC_WRITE_ERR){
+		NFC_broadcastStored(NFC_getBroadcastBlkAddress(&oNFC), oNFC.broadcast.pNfcData, oNFC.broadcast.length);
 	}
+	return err;
 }
\ No newline at end of file
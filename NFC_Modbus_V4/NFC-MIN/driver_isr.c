@@ -57,9 +57,7 @@ ISR(USART0_RXC_vect)
 	 * Otherwise interrupt flag can be cleared by writing 1 to its bit location
 	 * in the STATUS register
 	 */
-	USART_StoreData();
-	MinSlave_manageMessages();
-	USART_ClearRxBuffer();
+	MinSlave_serviceRx();		//Reads the character into the Modbus frame buffer
 }
 
 
@@ -74,15 +72,37 @@ ISR(USART0_TXC_vect)
 	
 	if(USART0.STATUS & USART_TXCIF_bm)
 	{
-		MinUart_serviceTx(&oMinSlave.uart);
-		USART_ClearRxBuffer();
+		USART0.STATUS = USART_TXCIF_bm;		//Clear the transmission complete status bit
+		if(HardwareUart_TxDone())			//Not a gap in the middle of a reply
+		{
+			HardwareUart_EndTx();
+			MinUart_serviceTx(&oMinSlave.uart);
+		}
 	}
-	USART0.STATUS |= (0<<USART_TXCIE_bp);  //Clear the transmission complete status bit
 }
 
 ISR(USART0_DRE_vect)
 {
+	//Send next character of the transmit buffer
+	USART_ServiceTx();
+}
+
+ISR(TCB0_INT_vect)
+{
+	//Modbus t1.5/t3.5 frame timer
+	MinUart_serviceFrameTimer(&oMinSlave.uart);
+
+	/* The interrupt flag has to be cleared manually */
+	TCB0.INTFLAGS = TCB_CAPT_bm;
+}
+
+ISR(TCB1_INT_vect)
+{
+	//Reply turnaround elapsed, send reply if queued
+	Turnaround_elapsed();
 
+	/* The interrupt flag has to be cleared manually */
+	TCB1.INTFLAGS = TCB_CAPT_bm;
 }
 
 ISR(TCA0_OVF_vect)
@@ -117,11 +137,6 @@ ISR(TCA0_OVF_vect)
 		}
 	}
 	
-	if (oMinSlave.uart.modbusReSync) 
-	{	// Count for no MIN UART transmission lately
-		oMinSlave.uart.modbusReSync--;
-	}
-
 	/* The interrupt flag has to be cleared manually */
 	TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm;
 }
\ No newline at end of file
@@ -196,6 +196,99 @@ static inline bool PA2_get_level()
 	return PORTA_get_pin_level(2);
 }
 
+/**
+ * \brief Set PA4 pull mode
+ *
+ * Configure pin to pull up, down or disable pull mode, supported pull
+ * modes are defined by device used
+ *
+ * \param[in] pull_mode Pin pull mode
+ */
+static inline void PA4_set_pull_mode(const enum port_pull_mode pull_mode)
+{
+	PORTA_set_pin_pull_mode(4, pull_mode);
+}
+
+/**
+ * \brief Set PA4 data direction
+ *
+ * Select if the pin data direction is input, output or disabled.
+ * If disabled state is not possible, this function throws an assert.
+ *
+ * \param[in] direction PORT_DIR_IN  = Data direction in
+ *                      PORT_DIR_OUT = Data direction out
+ *                      PORT_DIR_OFF = Disables the pin
+ *                      (low power state)
+ */
+static inline void PA4_set_dir(const enum port_dir dir)
+{
+	PORTA_set_pin_dir(4, dir);
+}
+
+/**
+ * \brief Set PA4 input/sense configuration
+ *
+ * Enable/disable PA4 digital input buffer and pin change interrupt,
+ * select pin interrupt edge/level sensing mode
+ *
+ * \param[in] isc PORT_ISC_INTDISABLE_gc    = Iterrupt disabled but input buffer enabled
+ *                PORT_ISC_BOTHEDGES_gc     = Sense Both Edges
+ *                PORT_ISC_RISING_gc        = Sense Rising Edge
+ *                PORT_ISC_FALLING_gc       = Sense Falling Edge
+ *                PORT_ISC_INPUT_DISABLE_gc = Digital Input Buffer disabled
+ *                PORT_ISC_LEVEL_gc         = Sense low Level
+ */
+static inline void PA4_set_isc(const PORT_ISC_t isc)
+{
+	PORTA_pin_set_isc(4, isc);
+}
+
+/**
+ * \brief Set PA4 inverted mode
+ *
+ * Enable or disable inverted I/O on a pin
+ *
+ * \param[in] inverted true  = I/O on PA4 is inverted
+ *                     false = I/O on PA4 is not inverted
+ */
+static inline void PA4_set_inverted(const bool inverted)
+{
+	PORTA_pin_set_inverted(4, inverted);
+}
+
+/**
+ * \brief Set PA4 level
+ *
+ * Sets output level on a pin
+ *
+ * \param[in] level true  = Pin level set to "high" state
+ *                  false = Pin level set to "low" state
+ */
+static inline void PA4_set_level(const bool level)
+{
+	PORTA_set_pin_level(4, level);
+}
+
+/**
+ * \brief Toggle output level on PA4
+ *
+ * Toggle the pin level
+ */
+static inline void PA4_toggle_level()
+{
+	PORTA_toggle_pin_level(4);
+}
+
+/**
+ * \brief Get level on PA4
+ *
+ * Reads the level on a pin
+ */
+static inline bool PA4_get_level()
+{
+	return PORTA_get_pin_level(4);
+}
+
 /**
  * \brief Set Tx_Enable pull mode
  *
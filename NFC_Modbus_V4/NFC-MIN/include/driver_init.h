@@ -47,6 +47,7 @@
 
 #include <interrupt_avr8.h>
 #include <tca.h>
+#include <tcb.h>
 
 #include <cpuint.h>
 #include <slpctrl.h>
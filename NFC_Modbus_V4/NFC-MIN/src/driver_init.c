@@ -66,6 +66,18 @@ void USART_0_initialization(void)
 	/* set the alternate pin mux */
 	PORTMUX.CTRLB |= PORTMUX_USART0_bm;
 
+#if RS485_XDIR_MODE
+	// Set pin direction to output
+	PA4_set_dir(PORT_DIR_OUT);
+
+	PA4_set_level(
+	    // <y> Initial level
+	    // <id> pad_initial_level
+	    // <false"> Low
+	    // <true"> High
+	    false);
+#endif
+
 	USART_0_init();
 }
 
@@ -75,6 +87,18 @@ void TIMER_0_initialization(void)
 	TIMER_0_init();
 }
 
+void TIMER_1_initialization(void)
+{
+
+	TIMER_1_init();
+}
+
+void TIMER_2_initialization(void)
+{
+
+	TIMER_2_init();
+}
+
 /**
  * \brief System initialization
  */
@@ -126,6 +150,10 @@ void system_init()
 
 	TIMER_0_initialization();
 
+	TIMER_1_initialization();
+
+	TIMER_2_initialization();
+
 	CPUINT_init();
 
 	SLPCTRL_init();
@@ -56,7 +56,11 @@ int8_t USART_0_init()
 	USART0.CTRLA = 0 << USART_ABEIE_bp    /* Auto-baud Error Interrupt Enable: disabled */
 	               | 0 << USART_DREIE_bp  /* Data Register Empty Interrupt Enable: disabled */
 	               | 0 << USART_LBME_bp   /* Loop-back Mode Enable: disabled */
+#if RS485_XDIR_MODE
+	               | USART_RS485_EXT_gc   /* RS485 Mode external, XDIR drives transceiver DE */
+#else
 	               | USART_RS485_OFF_gc   /* RS485 Mode disabled */
+#endif
 	               | 1 << USART_RXCIE_bp  /* Receive Complete Interrupt Enable: enabled */
 	               | 0 << USART_RXSIE_bp  /* Receiver Start Frame Interrupt Enable: disabled */
 	               | 1 << USART_TXCIE_bp; /* Transmit Complete Interrupt Enable: enabled */